@@ -0,0 +1,209 @@
+// ベンチマークの共通部分
+// 各構造の Benchmark/*.cpp がこれを include して、操作ごとに run() を呼ぶ。
+// 結果は 1 行 1 個の JSON (JSON Lines) で標準出力に出すので、版ごとに保存して diff や jq で比べる。
+//
+// 引数は key=value で、N=1000000 Q=1000000 seed=0 のように渡す。
+// キャッシュミスは Linux の perf_event で数える。使えない環境 (権限が無い, Linux でない) では -1。
+// ピーク RSS は getrusage の ru_maxrss (KB) なので、プロセス開始からの最大値。
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <map>
+#include <chrono>
+#include <random>
+#include <functional>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+namespace Bench {
+	class Args {
+	private:
+		map<string, string> kv;
+
+	public:
+		Args(int argc, char** argv) {
+			for (int i = 1; i < argc; ++i) {
+				string s = argv[i];
+				size_t p = s.find('=');
+				if (p == string::npos) kv[s] = "1";
+				else kv[s.substr(0, p)] = s.substr(p + 1);
+			}
+		}
+
+		long long get(const string& key, long long def) const {
+			auto it = kv.find(key);
+			return it == kv.end() ? def : stoll(it->second);
+		}
+		string get(const string& key, const string& def) const {
+			auto it = kv.find(key);
+			return it == kv.end() ? def : it->second;
+		}
+		// workload=random のように絞る。指定が無ければ全部
+		bool enabled(const string& key, const string& value) const {
+			auto it = kv.find(key);
+			return it == kv.end() || it->second == value;
+		}
+	};
+
+	// 計測区間のキャッシュミス数
+	class CacheMisses {
+	private:
+		int fd = -1;
+
+	public:
+		CacheMisses() {
+#if defined(__linux__)
+			perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.type = PERF_TYPE_HARDWARE;
+			attr.size = sizeof(attr);
+			attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.inherit = 1; // スレッドを立てる構築も数える
+			fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+		}
+		~CacheMisses() {
+#if defined(__linux__)
+			if (fd != -1) close(fd);
+#endif
+		}
+		CacheMisses(const CacheMisses&) = delete;
+		CacheMisses& operator=(const CacheMisses&) = delete;
+
+		bool available() const { return fd != -1; }
+
+		void start() {
+#if defined(__linux__)
+			if (fd == -1) return;
+			ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+			ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+		}
+
+		// 使えなければ -1
+		long long stop() {
+#if defined(__linux__)
+			if (fd == -1) return -1;
+			ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+			long long count = 0;
+			if (read(fd, &count, sizeof(count)) != (ssize_t)sizeof(count)) return -1;
+			return count;
+#else
+			return -1;
+#endif
+		}
+	};
+
+	// KB。取れなければ -1
+	inline long long peak_rss_kb() {
+#if defined(__APPLE__)
+		rusage ru;
+		getrusage(RUSAGE_SELF, &ru);
+		return ru.ru_maxrss / 1024;
+#elif defined(__unix__)
+		rusage ru;
+		getrusage(RUSAGE_SELF, &ru);
+		return ru.ru_maxrss;
+#else
+		return -1;
+#endif
+	}
+
+	// 結果を使ったことにして、計算ごと消されないようにする
+	template<class T>
+	inline void keep(const T& x) {
+#if defined(__GNUC__)
+		asm volatile("" : : "g"(&x) : "memory");
+#else
+		static volatile const void* sink;
+		sink = &x;
+#endif
+	}
+
+	struct Result {
+		string bench, op, workload;
+		long long N, Q; // Q: 計測区間の操作の回数
+		double sec;
+		long long cache_misses, peak_rss_kb;
+
+		double ns_per_op() const { return Q == 0 ? 0 : sec * 1e9 / Q; }
+		double ops_per_sec() const { return sec == 0 ? 0 : Q / sec; }
+
+		string to_json() const {
+			char buf[512];
+			snprintf(buf, sizeof(buf),
+				"{\"bench\":\"%s\",\"op\":\"%s\",\"workload\":\"%s\",\"N\":%lld,\"Q\":%lld,\"sec\":%.6f,\"ns_per_op\":%.3f,\"ops_per_sec\":%.1f,\"cache_misses\":%lld,\"peak_rss_kb\":%lld}",
+				bench.c_str(), op.c_str(), workload.c_str(), N, Q, sec, ns_per_op(), ops_per_sec(), cache_misses, peak_rss_kb);
+			return buf;
+		}
+	};
+
+	// f() が Q 回の操作をする。結果を 1 行出して返す
+	template<class F>
+	Result run(const string& bench, const string& op, const string& workload, long long N, long long Q, const F& f) {
+		CacheMisses cm;
+		cm.start();
+		auto start = chrono::steady_clock::now();
+		f();
+		double sec = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		long long misses = cm.stop();
+		Result res{ bench, op, workload, N, Q, sec, misses, peak_rss_kb() };
+		cout << res.to_json() << endl;
+		return res;
+	}
+
+	// 半開区間 [l, r) のクエリの作り方
+	//   random: 一様
+	//   sequential: 幅 N / 16 の窓を左から 1 つずつずらす (キャッシュに優しい)
+	//   adversarial: [1, N - 1) 付近。ボトムアップのセグ木で触るノードが最大になる
+	inline vector<pair<int, int>> ranges(const string& workload, int N, int Q, mt19937_64& rng) {
+		vector<pair<int, int>> res(Q);
+		int W = max(1, N / 16);
+		for (int i = 0; i < Q; ++i) {
+			int l, r;
+			if (workload == "sequential") l = i % max(1, N - W + 1), r = min(N, l + W);
+			else if (workload == "adversarial") l = min(N, 1 + (int)(rng() % 2)), r = max(l, N - 1 - (int)(rng() % 2));
+			else {
+				l = (int)(rng() % (N + 1)), r = (int)(rng() % (N + 1));
+				if (l > r) swap(l, r);
+			}
+			res[i] = { l, r };
+		}
+		return res;
+	}
+
+	// 関数グラフの作り方
+	//   random: 行き先が一様
+	//   sequential: 長さ N のサイクル 1 本 (i -> i + 1)
+	//   adversarial: 長さ N - 16 の尻尾の先に長さ 16 のサイクル (木の部分が深い)
+	inline vector<int> functional_graph(const string& workload, int N, mt19937_64& rng) {
+		vector<int> G(N);
+		for (int i = 0; i < N; ++i) {
+			if (workload == "sequential") G[i] = (i + 1) % N;
+			else if (workload == "adversarial") G[i] = (i + 1 < N ? i + 1 : max(0, N - 16));
+			else G[i] = (int)(rng() % N);
+		}
+		return G;
+	}
+
+	inline const vector<string>& workloads() {
+		static const vector<string> res = { "random", "sequential", "adversarial" };
+		return res;
+	}
+} // namespace Bench
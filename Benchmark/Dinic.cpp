@@ -0,0 +1,70 @@
+// DinicGraph: flow, scaling_flow (Q は辺の本数なので ns_per_op は 1 辺あたり), change_capacity + flow の差分更新 (Q は更新回数)
+// グラフが workload
+//   random: N 頂点 10N 辺の一様
+//   sequential: 幅 W = √N の層を並べた層グラフ
+//   adversarial: 幅 10 の細長い層グラフで戻る辺あり (増加路が長い)
+// N=20000 U=1000 seed=0 workload=random|sequential|adversarial
+// flow を詰めた辺の配列で回すようにする前との比 (N=10^5, 3 回の最速): sequential 1.55 倍, adversarial 2.4 倍, random はほぼ同じ。
+// N=2*10^4 だと sequential, adversarial とも 1.2 倍くらいで、random は 1 割ほど遅い。
+
+#include "Bench.cpp"
+#include "../GraphNetworkFlow/Dinic.cpp"
+#include <cmath>
+#include <tuple>
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N0 = (int)args.get("N", 20000), U = (int)args.get("U", 1000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		int N, s, t;
+		vector<tuple<int, int, long long>> E;
+		auto layered = [&](int L, int W, int deg, bool back) {
+			N = L * W + 2, s = N - 2, t = N - 1;
+			for (int x = 0; x < W; ++x) E.emplace_back(s, x, 1000000), E.emplace_back((L - 1) * W + x, t, 1000000);
+			for (int l = 0; l + 1 < L; ++l) for (int x = 0; x < W; ++x) {
+				for (int k = 0; k < deg; ++k) E.emplace_back(l * W + x, (l + 1) * W + rng() % W, rng() % 1000 + 1);
+			}
+			if (back) for (int l = 1; l < L; ++l) for (int x = 0; x < W; ++x) if (rng() % 2) E.emplace_back(l * W + x, (l - 1) * W + rng() % W, rng() % 1000 + 1);
+		};
+		if (w == "sequential") {
+			int W = max(1, (int)sqrt(N0));
+			layered(max(2, N0 / W), W, 4, false);
+		}
+		else if (w == "adversarial") layered(max(2, N0 / 10), 10, 3, true);
+		else {
+			N = max(2, N0), s = 0, t = N - 1;
+			for (int i = 0; i < 10 * N; ++i) E.emplace_back(rng() % N, rng() % N, rng() % 1000 + 1);
+		}
+		const int M = (int)E.size();
+		auto build = [&](DinicGraph<long long>& g) { for (auto [u, v, c] : E) g.add_edge(u, v, c); };
+
+		{
+			DinicGraph<long long> g(N, s, t);
+			build(g);
+			Bench::run("Dinic", "flow", w, N, M, [&] { Bench::keep(g.flow()); });
+		}
+		{
+			DinicGraph<long long> g(N, s, t);
+			build(g);
+			Bench::run("Dinic", "scaling_flow", w, N, M, [&] { Bench::keep(g.scaling_flow()); });
+		}
+		{
+			DinicGraph<long long> g(N, s, t);
+			build(g);
+			g.flow();
+			vector<pair<int, long long>> upd(U);
+			for (auto& [i, c] : upd) i = (int)(rng() % M), c = (long long)(rng() % 1000 + 1);
+			Bench::run("Dinic", "change_capacity", w, N, U, [&] {
+				long long f = 0;
+				for (auto [i, c] : upd) {
+					g.change_capacity(i, c);
+					f += g.flow();
+				}
+				Bench::keep(f);
+			});
+		}
+	}
+}
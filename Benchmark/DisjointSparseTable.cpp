@@ -0,0 +1,47 @@
+// DisjointSparseTable と SegTree の構築と prod を同じクエリで比べる
+// 表は (log2 N + 1) N 個なので、long long で N=10^7 は 2GB、N=10^8 は 22GB くらい要る
+// N=1000000 Q=10000000 threads=4 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../DataStructure/SegTree.cpp"
+#include "../DataStructure/DisjointSparseTable.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 10000000), threads = (int)args.get("threads", 4);
+	mt19937_64 rng(args.get("seed", 0));
+
+	vector<long long> A(N);
+	for (auto& a : A) a = (long long)(rng() % 1000000000);
+	auto op = [](long long g, long long f) { return g + f; };
+
+	Bench::run("DisjointSparseTable", "build", "random", N, N, [&] {
+		DisjointSparseTable<long long> dst(A, op, 0LL);
+		Bench::keep(dst);
+	});
+	Bench::run("DisjointSparseTable", "build_threads" + to_string(threads), "random", N, N, [&] {
+		DisjointSparseTable<long long> dst(A, op, 0LL, threads);
+		Bench::keep(dst);
+	});
+	Bench::run("DisjointSparseTable", "segtree_build", "random", N, N, [&] {
+		SegTree<long long> seg(A, op, 0LL);
+		Bench::keep(seg);
+	});
+
+	DisjointSparseTable<long long> dst(A, op, 0LL, threads);
+	SegTree<long long> seg(A, op, 0LL);
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		auto q = Bench::ranges(w, N, Q, rng);
+		long long s1 = 0, s2 = 0;
+		Bench::run("DisjointSparseTable", "prod", w, N, Q, [&] {
+			for (auto [l, r] : q) s1 += dst.prod(l, r);
+			Bench::keep(s1);
+		});
+		Bench::run("DisjointSparseTable", "segtree_prod", w, N, Q, [&] {
+			for (auto [l, r] : q) s2 += seg.prod(l, r);
+			Bench::keep(s2);
+		});
+		if (s1 != s2) cerr << "wrong answer" << endl;
+	}
+}
@@ -0,0 +1,46 @@
+// DoubleSigma の各カーネル (Q は要素数なので ns_per_op は 1 要素あたり)
+// workload は DoubleSigmaVerifier::generators() の名前 (uniform, all equal, small, powers of two, near max, primes)
+// atcoder library が要る
+// N=200000 max_a=1000000 threads=4 seed=0 workload=uniform|...
+
+#include "Bench.cpp"
+#include "../Math/DoubleSigma.cpp"
+
+int main(int argc, char** argv) {
+	using T = long long;
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 200000), threads = (int)args.get("threads", 4);
+	const long long max_a = args.get("max_a", 1000000);
+	const unsigned long long seed = args.get("seed", 0);
+
+	vector<pair<string, function<T(const vector<T>&)>>> kernels = {
+		{ "FloorXoverY", DoubleSigma::FloorXoverY<T> },
+		{ "XmodY", DoubleSigma::XmodY<T> },
+		{ "FloorAllPairs", [](const vector<T>& A) { return DoubleSigma::FloorAllPairs<T>(A); } },
+		{ "FloorAllPairs_threads" + to_string(threads), [&](const vector<T>& A) { return DoubleSigma::FloorAllPairs<T>(A, threads); } },
+		{ "XmodYAllPairs", [](const vector<T>& A) { return DoubleSigma::XmodYAllPairs<T>(A); } },
+		{ "FloorXoverYLarge", DoubleSigma::FloorXoverYLarge<T> },
+		{ "XmodYLarge", DoubleSigma::XmodYLarge<T> },
+		{ "FloorAllPairsLarge", DoubleSigma::FloorAllPairsLarge<T> },
+		{ "XmodYAllPairsLarge", DoubleSigma::XmodYAllPairsLarge<T> },
+		{ "XxorY", DoubleSigma::XxorY<T> },
+		{ "AbsXminusY", DoubleSigma::AbsXminusY<T> },
+		{ "XgcdY", DoubleSigma::XgcdY<T> },
+		{ "XlcmY", [](const vector<T>& A) { return (T)DoubleSigma::XlcmY(vector<int>(A.begin(), A.end())).val(); } },
+		{ "Multiset_insert", [&](const vector<T>& A) {
+			DoubleSigmaMultiset<T> ms((int)max_a);
+			for (T a : A) ms.insert((int)a);
+			return ms.floor_sum();
+		} },
+	};
+
+	for (auto& [g_name, gen] : DoubleSigmaVerifier<T>::generators()) {
+		if (!args.enabled("workload", g_name)) continue;
+		mt19937_64 rng(seed);
+		vector<T> A = gen(N, max_a, rng);
+		for (auto& [k_name, f] : kernels) {
+			if (!args.enabled("kernel", k_name)) continue;
+			Bench::run("DoubleSigma", k_name, g_name, N, N, [&] { Bench::keep(f(A)); });
+		}
+	}
+}
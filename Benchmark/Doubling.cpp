@@ -0,0 +1,47 @@
+// Doubling: 構築 (Custom の op と SIMD の Sum, スレッド数), prod, prod_batch
+// 表は log2(max_k) 段なので、N=10^6, max_k=10^9 で 360MB くらい
+// N=200000 Q=1000000 max_k=1000000000 threads=4 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../Graph/Doubling.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 200000), Q = (int)args.get("Q", 1000000), threads = (int)args.get("threads", 4);
+	const unsigned long long max_k = args.get("max_k", 1000000000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	vector<long long> value(N);
+	for (auto& x : value) x = (long long)(rng() % 1000000000);
+
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		vector<int> G = Bench::functional_graph(w, N, rng);
+		vector<pair<int, unsigned long long>> q(Q);
+		for (auto& [s, k] : q) s = (int)(rng() % N), k = rng() % (max_k + 1);
+
+		Bench::run("Doubling", "build_custom", w, N, N, [&] {
+			Doubling<long long> db(N, G, value, [](long long a, long long b) { return a + b; }, max_k);
+			Bench::keep(db);
+		});
+		Bench::run("Doubling", "build_sum", w, N, N, [&] {
+			Doubling<long long> db(N, G, value, DoublingOp::Sum, max_k);
+			Bench::keep(db);
+		});
+		Bench::run("Doubling", "build_sum_threads" + to_string(threads), w, N, N, [&] {
+			Doubling<long long> db(N, G, value, DoublingOp::Sum, max_k, threads);
+			Bench::keep(db);
+		});
+
+		Doubling<long long> db(N, G, value, DoublingOp::Sum, max_k, threads);
+		Bench::run("Doubling", "prod", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [v, k] : q) s += db.prod(v, k);
+			Bench::keep(s);
+		});
+		Bench::run("Doubling", "prod_batch", w, N, Q, [&] {
+			auto res = db.prod_batch(q);
+			Bench::keep(res);
+		});
+	}
+}
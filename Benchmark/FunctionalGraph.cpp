@@ -0,0 +1,45 @@
+// FunctionalGraph: 構築 (1 スレッド, threads スレッド, ダブリング付き), Move (HLD 版とダブリング版)
+// N=1000000 Q=1000000 threads=4 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../Graph/FunctionalGraph.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 1000000), threads = (int)args.get("threads", 4);
+	mt19937_64 rng(args.get("seed", 0));
+
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		vector<int> G = Bench::functional_graph(w, N, rng);
+		vector<pair<int, unsigned long long>> q(Q);
+		for (auto& [v, k] : q) v = (int)(rng() % N), k = rng() % 1000000000000000000ULL;
+
+		Bench::run("FunctionalGraph", "build", w, N, N, [&] {
+			FunctionalGraph fg(G);
+			Bench::keep(fg);
+		});
+		Bench::run("FunctionalGraph", "build_threads" + to_string(threads), w, N, N, [&] {
+			FunctionalGraph fg(G, false, threads);
+			Bench::keep(fg);
+		});
+
+		FunctionalGraph fg(G);
+		Bench::run("FunctionalGraph", "Move", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [v, k] : q) s += fg.Move(v, k);
+			Bench::keep(s);
+		});
+		// 表が 64N 個なので大きい N では重い
+		if (args.get("doubling", 1)) {
+			FunctionalGraph* fd = nullptr;
+			Bench::run("FunctionalGraph", "build_doubling", w, N, N, [&] { fd = new FunctionalGraph(G, true); });
+			Bench::run("FunctionalGraph", "Move_doubling", w, N, Q, [&] {
+				long long s = 0;
+				for (auto [v, k] : q) s += fd->Move(v, k);
+				Bench::keep(s);
+			});
+			delete fd;
+		}
+	}
+}
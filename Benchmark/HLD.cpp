@@ -0,0 +1,51 @@
+// HLD: 構築, lca, path_prod (区間和は累積和で O(1) にして、HLD 自体の分解の重さを見る)
+// 木の形が workload
+//   random: 親を一様に選ぶ (深さ O(log N))
+//   sequential: 64 本の長いパスが根から出ている (heavy path が長い)
+//   adversarial: 完全二分木 (パスが通る light edge が最大の log N 本)
+// N=1000000 Q=1000000 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../DataStructure/HLD.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 1000000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		vector<vector<int>> G(N);
+		for (int v = 1; v < N; ++v) {
+			int p;
+			if (w == "sequential") p = max(0, v - 64);
+			else if (w == "adversarial") p = (v - 1) / 2;
+			else p = (int)(rng() % v);
+			G[p].emplace_back(v), G[v].emplace_back(p);
+		}
+		vector<pair<int, int>> q(Q);
+		for (auto& [u, v] : q) u = (int)(rng() % N), v = (int)(rng() % N);
+
+		HLD<int>* hld = nullptr;
+		Bench::run("HLD", "build", w, N, N, [&] { hld = new HLD<int>(G); });
+
+		// HLD の順に並べた値の累積和
+		vector<long long> S(N + 1);
+		for (int v = 0; v < N; ++v) S[hld->index(v) + 1] = v;
+		for (int i = 0; i < N; ++i) S[i + 1] += S[i];
+		function<long long(int, int)> sum = [&](int l, int r) { return S[r] - S[l]; };
+		function<long long(long long, long long)> op = [](long long a, long long b) { return a + b; };
+
+		Bench::run("HLD", "lca", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [u, v] : q) s += hld->lca(u, v);
+			Bench::keep(s);
+		});
+		Bench::run("HLD", "path_prod", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [u, v] : q) s += hld->path_prod<long long>(u, v, 0LL, sum, sum, op);
+			Bench::keep(s);
+		});
+		delete hld;
+	}
+}
@@ -0,0 +1,46 @@
+// LazySegTree: 区間加算・区間和で 構築, apply(l, r), prod, 半々
+// N=1000000 Q=1000000 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../DataStructure/LazySegTree.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 1000000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	vector<long long> A(N);
+	for (auto& a : A) a = (long long)(rng() % 1000000000);
+	auto op = [](long long a, long long b) { return a + b; };
+	auto mapping = [](long long f, long long x) { return f + x; };
+	auto composition = [](long long g, long long f) { return g + f; };
+	auto power = [](long long f, int k) { return f * k; };
+	auto make = [&] { return LazySegTree<long long, long long>(A, op, 0LL, mapping, composition, power, 0LL); };
+
+	Bench::run("LazySegTree", "build", "random", N, N, [&] {
+		auto seg = make();
+		Bench::keep(seg);
+	});
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		auto q = Bench::ranges(w, N, Q, rng);
+
+		auto seg = make();
+		Bench::run("LazySegTree", "apply", w, N, Q, [&] {
+			for (int i = 0; i < Q; ++i) seg.apply(q[i].first, q[i].second, i & 15);
+		});
+		Bench::run("LazySegTree", "prod", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [l, r] : q) s += seg.prod(l, r);
+			Bench::keep(s);
+		});
+		Bench::run("LazySegTree", "mixed", w, N, Q, [&] {
+			long long s = 0;
+			for (int i = 0; i < Q; ++i) {
+				if (i & 1) seg.apply(q[i].first, q[i].second, s & 15);
+				else s += seg.prod(q[i].first, q[i].second);
+			}
+			Bench::keep(s);
+		});
+	}
+}
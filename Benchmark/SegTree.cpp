@@ -0,0 +1,44 @@
+// SegTree: 構築, prod, set, prod と set 半々
+// N=1000000 Q=1000000 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+#include "../DataStructure/SegTree.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 1000000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	vector<long long> A(N);
+	for (auto& a : A) a = (long long)(rng() % 1000000000);
+	auto op = [](long long g, long long f) { return g + f; };
+
+	Bench::run("SegTree", "build", "random", N, N, [&] {
+		SegTree<long long> seg(A, op, 0LL);
+		Bench::keep(seg);
+	});
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		auto q = Bench::ranges(w, N, Q, rng);
+		vector<int> pos(Q);
+		for (int i = 0; i < Q; ++i) pos[i] = (w == "sequential" ? i % N : (int)(rng() % N));
+
+		SegTree<long long> seg(A, op, 0LL);
+		Bench::run("SegTree", "set", w, N, Q, [&] {
+			for (int i = 0; i < Q; ++i) seg.set(pos[i], A[i % N]);
+		});
+		Bench::run("SegTree", "prod", w, N, Q, [&] {
+			long long s = 0;
+			for (auto [l, r] : q) s += seg.prod(l, r);
+			Bench::keep(s);
+		});
+		Bench::run("SegTree", "mixed", w, N, Q, [&] {
+			long long s = 0;
+			for (int i = 0; i < Q; ++i) {
+				if (i & 1) seg.set(pos[i], s & 1023);
+				else s += seg.prod(q[i].first, q[i].second);
+			}
+			Bench::keep(s);
+		});
+	}
+}
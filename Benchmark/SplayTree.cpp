@@ -0,0 +1,53 @@
+// SplayArray: get, set, reverse, prod, reverse と prod 半々
+// sequential の get / set は添字を 1 ずつ進める (splay に有利)
+// N=1000000 Q=1000000 seed=0 workload=random|sequential|adversarial
+
+#include "Bench.cpp"
+using ll = long long;
+#define rep(i, n) for (int i = 0; i < (int)(n); ++i)
+#include "../DataStructure/SplayTree.cpp"
+
+int main(int argc, char** argv) {
+	Bench::Args args(argc, argv);
+	const int N = (int)args.get("N", 1000000), Q = (int)args.get("Q", 1000000);
+	mt19937_64 rng(args.get("seed", 0));
+
+	vector<ll> A(N);
+	for (auto& a : A) a = (ll)(rng() % 1000000000);
+
+	for (const string& w : Bench::workloads()) {
+		if (!args.enabled("workload", w)) continue;
+		auto q = Bench::ranges(w, N, Q, rng);
+		vector<int> pos(Q);
+		for (int i = 0; i < Q; ++i) pos[i] = (w == "sequential" ? i % N : (int)(rng() % N));
+
+		SplayArray<ll, op, e> sp(N);
+		Bench::run("SplayArray", "build", w, N, N, [&] {
+			for (int i = 0; i < N; ++i) sp.set(i, A[i]);
+		});
+		Bench::run("SplayArray", "get", w, N, Q, [&] {
+			ll s = 0;
+			for (int i = 0; i < Q; ++i) s += sp.get(pos[i]);
+			Bench::keep(s);
+		});
+		Bench::run("SplayArray", "set", w, N, Q, [&] {
+			for (int i = 0; i < Q; ++i) sp.set(pos[i], A[i % N]);
+		});
+		Bench::run("SplayArray", "reverse", w, N, Q, [&] {
+			for (auto [l, r] : q) sp.reverse(l, r);
+		});
+		Bench::run("SplayArray", "prod", w, N, Q, [&] {
+			ll s = 0;
+			for (auto [l, r] : q) s += sp.prod(l, r);
+			Bench::keep(s);
+		});
+		Bench::run("SplayArray", "mixed", w, N, Q, [&] {
+			ll s = 0;
+			for (int i = 0; i < Q; ++i) {
+				if (i & 1) sp.reverse(q[i].first, q[i].second);
+				else s += sp.prod(q[i].first, q[i].second);
+			}
+			Bench::keep(s);
+		});
+	}
+}
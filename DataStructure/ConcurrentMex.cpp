@@ -0,0 +1,151 @@
+#include <vector>
+#include <atomic>
+#include <bit>
+
+using namespace std;
+
+// Mex のスレッドセーフ版。空き ID の最小値を割り当てるアロケータとして使う想定。
+// bits の構造は Mex と同じ (欠損している値の bit が立つ 64 分木) で、各ワードを atomic に持つ。
+// 上位レベルの bit は「下のワードが非 0 かもしれない」というヒントで、一時的に古くてもよい。
+// 操作が止まった時点では Mex と同じ状態に収束する。
+class ConcurrentMex {
+	int N;
+	vector<atomic<int>> cnt;
+	vector<vector<atomic<unsigned long long>>> bits;
+
+public:
+	ConcurrentMex(int max_n) : N(max_n), cnt(N + 1) {
+		int n = N + 1;
+		do {
+			int w = (n + 63) >> 6;
+			bits.emplace_back(w);
+			for (int i = 0; i < w; ++i) bits.back()[i].store(~0ull, memory_order_relaxed);
+			if (n & 63) bits.back().back().store((1ull << (n & 63)) - 1, memory_order_relaxed);
+			n = w;
+		} while (n > 1);
+	}
+
+	// 現在の mex を確保して返す。空きが無ければ -1
+	int acquire() {
+		int x = 0;
+		while (true) {
+			x = find(x);
+			if (N < x) return -1;
+			int z = 0;
+			if (cnt[x].compare_exchange_strong(z, 1)) {
+				sync(x);
+				return x;
+			}
+			++x; // 他のスレッドに取られた
+		}
+	}
+
+	void release(int id) { erase(id); }
+
+	// 以下は Mex と同じ多重集合としての操作
+	void insert(int x) {
+		if (x < 0 || N < x) return;
+		if (cnt[x].fetch_add(1) == 0) sync(x);
+	}
+
+	void erase(int x) {
+		if (x < 0 || N < x) return;
+		int c = cnt[x].load();
+		while (c > 0 && !cnt[x].compare_exchange_weak(c, c - 1)) {}
+		if (c == 1) sync(x);
+	}
+
+	int count(int x) const { return (x < 0 || N < x) ? 0 : cnt[x].load(); }
+
+	// 確保はしない。並行に更新されている場合はその途中のどこかの時点での値
+	int operator()() const { return find(0); }
+
+private:
+	// x 以上で bit が立っている最小の値。無ければ N + 1
+	int find(int x) const {
+		while (x <= N) {
+			int h = 0;
+			for (; h < (int)bits.size(); ++h) {
+				int i = x >> 6;
+				if (i >= (int)bits[h].size()) return N + 1;
+				unsigned long long w = bits[h][i].load() & (~0ull << (x & 63));
+				if (w) {
+					x = (i << 6) | countr_zero(w);
+					break;
+				}
+				x = i + 1;
+			}
+			if (h == (int)bits.size()) return N + 1;
+
+			int g = h - 1;
+			for (; g >= 0; --g) {
+				unsigned long long w = bits[g][x].load();
+				if (!w) break; // ヒントが古い。右隣から探し直す
+				x = (x << 6) | countr_zero(w);
+			}
+			if (g < 0) return x;
+			long long nx = (long long)(x + 1) << (6 * g + 6);
+			if (nx > N) return N + 1;
+			x = (int)nx;
+		}
+		return N + 1;
+	}
+
+	// 葉の bit を cnt[x] == 0 に合わせる。途中で cnt が変わったらやり直す
+	void sync(int x) {
+		while (true) {
+			bool free = (cnt[x].load() == 0);
+			if (free) set_bit(0, x);
+			else clear_bit(0, x);
+			if ((cnt[x].load() == 0) == free) return;
+		}
+	}
+
+	void set_bit(int h, int x) {
+		for (; h < (int)bits.size(); ++h, x >>= 6) {
+			unsigned long long b = 1ull << (x & 63);
+			unsigned long long prev = bits[h][x >> 6].fetch_or(b);
+			if (prev != 0) return;
+		}
+	}
+
+	// ワードが 0 になったら親の bit を落とし、その後ワードを見直して非 0 なら立て直す
+	void clear_bit(int h, int x) {
+		unsigned long long b = 1ull << (x & 63);
+		unsigned long long prev = bits[h][x >> 6].fetch_and(~b);
+		if (!(prev & b) || (prev & ~b) != 0) return;
+		if (h + 1 == (int)bits.size()) return;
+		clear_bit(h + 1, x >> 6);
+		if (bits[h][x >> 6].load() != 0) set_bit(h + 1, x >> 6);
+	}
+};
+
+//#include <mutex>
+//#include <thread>
+//#include <chrono>
+//#include <iostream>
+//#include "Mex.cpp"
+//
+//// 各スレッドが acquire / release を繰り返す。mutex で守った Mex と比較
+//int main() {
+//	const int N = 1 << 16, ITER = 1 << 18;
+//	for (int T = 1; T <= 64; T <<= 1) {
+//		Mex mex(N);
+//		mutex mtx;
+//		ConcurrentMex cmex(N);
+//		auto run = [&](auto&& body) {
+//			auto start = chrono::steady_clock::now();
+//			vector<thread> th;
+//			for (int t = 0; t < T; ++t) th.emplace_back([&] { for (int i = 0; i < ITER / T; ++i) body(); });
+//			for (auto& t : th) t.join();
+//			return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+//		};
+//		double a = run([&] {
+//			int id;
+//			{ lock_guard<mutex> lk(mtx); id = mex(); mex.insert(id); }
+//			{ lock_guard<mutex> lk(mtx); mex.erase(id); }
+//		});
+//		double b = run([&] { cmex.release(cmex.acquire()); });
+//		cout << T << " threads: mutex Mex " << a << " ms, ConcurrentMex " << b << " ms" << endl;
+//	}
+//}
@@ -0,0 +1,68 @@
+#include <vector>
+#include <functional>
+#include <cassert>
+#include <bit>
+#include <thread>
+using namespace std;
+
+// 静的な配列の区間積を、表を 2 回引いて op を 1 回で答える。結合的なら冪等でなくてよい。
+// 構築 O(N log N) 時間・メモリ。SegTree と同じく op(g, f) = g・f で、左から作用させる。
+// 段 k (l と r - 1 の最上位の異なる bit) では長さ 2^(k+1) のブロックの真ん中 mid から
+// 左側に [i, mid) の積、右側に [mid, i] の積を持つ。段どうし、ブロックどうしは独立なのでスレッドで分けて作る。
+template<typename T>
+class DisjointSparseTable {
+private:
+	const int N;
+	int LOG;
+	vector<T> data; // data[0, N) は元の配列、data[(k + 1) * N + i] は段 k
+	// op(g, f) := g(f(x)) = (g・f)(x), 数学に合わせて左右逆なので注意
+	const function<T(T, T)> op;
+	const T e;
+
+public:
+	DisjointSparseTable(int n, function<T(T, T)> op, T e, int threads = 1) : DisjointSparseTable(vector<T>(n, e), op, e, threads) {}
+
+	DisjointSparseTable(const vector<T>& A, function<T(T, T)> op, T e, int threads = 1) : N((int)A.size()), op(op), e(e) {
+		LOG = N <= 1 ? 0 : (int)bit_width((unsigned)N - 1);
+		data.resize((size_t)(LOG + 1) * N);
+		copy(A.begin(), A.end(), data.begin());
+
+		// (段, ブロック) を通し番号にして飛び飛びに配る。上の段ほどブロックが少なく長いので、区間で切ると偏る
+		vector<pair<int, int>> blocks;
+		for (int k = 0; k < LOG; ++k) {
+			for (int mid = 1 << k; mid < N; mid += 2 << k) blocks.emplace_back(k, mid);
+		}
+		threads = max(1, min(threads, N >> 14));
+		auto run = [&](int t) {
+			for (size_t b = t; b < blocks.size(); b += threads) build(blocks[b].first, blocks[b].second);
+		};
+		vector<thread> th;
+		for (int t = 1; t < threads; ++t) th.emplace_back(run, t);
+		run(0);
+		for (thread& t : th) t.join();
+	}
+
+	const T& operator[](int i) const { return data[i]; }
+	T get(int i) const { return data[i]; }
+	int size() const { return N; }
+
+	T prod(int l, int r) const {
+		assert(0 <= l && l <= r && r <= N);
+		if (l == r) return e;
+		if (l + 1 == r) return data[l];
+		const T* level = &data[(size_t)bit_width((unsigned)(l ^ (r - 1))) * N];
+		return op(level[r - 1], level[l]);
+	}
+
+	T all_prod() const { return prod(0, N); }
+
+private:
+	void build(int k, int mid) {
+		T* level = &data[(size_t)(k + 1) * N];
+		const int lo = mid - (1 << k), hi = min(N, mid + (1 << k));
+		level[mid - 1] = data[mid - 1];
+		for (int i = mid - 2; i >= lo; --i) level[i] = op(level[i + 1], data[i]);
+		level[mid] = data[mid];
+		for (int i = mid + 1; i < hi; ++i) level[i] = op(data[i], level[i - 1]);
+	}
+};
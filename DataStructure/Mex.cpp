@@ -2,31 +2,114 @@
 // https://atcoder.jp/contests/abc272/tasks/abc272_e
 
 #include <vector>
-#include <set>
+#include <bit>
 
 using namespace std;
 
+// [0, N] の値の多重集合を管理する。範囲外の値は常に「無い」扱い。
+// 欠損している値の bit を立てた 64 分木で持つので、各操作 O(log_64 N)。
+// kth_missing 用のワードごとの欠損数の BIT は最初に kth_missing を呼んだときに作る。それ以降の insert / erase は O(log(N / 64))。
 class Mex {
 	int N;
-	set<int> st;
 	vector<int> cnt;
+	// bits[0] の x bit 目: 値 x が無い。bits[h + 1] の i bit 目: bits[h][i] != 0
+	vector<vector<unsigned long long>> bits;
+	// ワードごとの欠損数の BIT。k 番目の欠損値用で、kth_missing を呼ぶまでは空
+	mutable vector<int> fw;
+
 public:
 	Mex(int max_n) : N(max_n), cnt(N + 1) {
-		for (int i = 0; i <= N; ++i) st.emplace(i);
+		int n = N + 1;
+		do {
+			int w = (n + 63) >> 6;
+			bits.emplace_back(w, ~0ull);
+			if (n & 63) bits.back().back() = (1ull << (n & 63)) - 1;
+			n = w;
+		} while (n > 1);
 	}
 
 	void insert(int x) {
 		if (x < 0 || N < x) return;
-		cnt[x]++;
-		st.erase(x);
+		if (cnt[x]++ == 0) reset(x);
 	}
 
 	void erase(int x) {
 		if (x < 0 || N < x) return;
 		if (cnt[x] == 0) return;
-		cnt[x]--;
-		if (cnt[x] == 0) st.insert(x);
+		if (--cnt[x] == 0) set(x);
+	}
+
+	int count(int x) const { return (x < 0 || N < x) ? 0 : cnt[x]; }
+
+	int operator()() const { return mex_at_least(0); }
+
+	// x 以上で最小の、集合に無い値
+	int mex_at_least(int x) const {
+		if (x < 0) x = 0;
+		if (N < x) return x;
+		for (int h = 0; h < (int)bits.size(); ++h) {
+			int i = x >> 6;
+			if (i >= (int)bits[h].size()) break;
+			unsigned long long w = bits[h][i] & (~0ull << (x & 63));
+			if (w) {
+				x = (i << 6) | countr_zero(w);
+				for (int g = h - 1; g >= 0; --g) x = (x << 6) | countr_zero(bits[g][x]);
+				return x;
+			}
+			x = i + 1;
+		}
+		return N + 1;
+	}
+
+	// 集合に無い値のうち小さい方から k 番目 (0-indexed)
+	int kth_missing(int k) const {
+		int W = (int)bits[0].size(), i = 0;
+		if (fw.empty()) build_fw();
+		for (int s = bit_floor((unsigned)W); s > 0; s >>= 1) {
+			if (i + s <= W && fw[i + s] <= k) {
+				i += s;
+				k -= fw[i];
+			}
+		}
+		if (i == W) return N + 1 + k;
+		unsigned long long w = bits[0][i];
+		for (; k > 0; --k) w &= w - 1;
+		return (i << 6) | countr_zero(w);
 	}
 
-	int operator()() const { return *st.begin(); }
+private:
+	void set(int x) {
+		fw_add(x >> 6, 1);
+		for (int h = 0; h < (int)bits.size(); ++h, x >>= 6) {
+			unsigned long long& w = bits[h][x >> 6];
+			bool was_empty = (w == 0);
+			w |= 1ull << (x & 63);
+			if (!was_empty) break;
+		}
+	}
+
+	void reset(int x) {
+		fw_add(x >> 6, -1);
+		for (int h = 0; h < (int)bits.size(); ++h, x >>= 6) {
+			unsigned long long& w = bits[h][x >> 6];
+			w &= ~(1ull << (x & 63));
+			if (w != 0) break;
+		}
+	}
+
+	// O(N / 64)
+	void build_fw() const {
+		int W = (int)bits[0].size();
+		fw.assign(W + 1, 0);
+		for (int i = 0; i < W; ++i) {
+			fw[i + 1] += popcount(bits[0][i]);
+			int j = (i + 1) + ((i + 1) & -(i + 1));
+			if (j <= W) fw[j] += fw[i + 1];
+		}
+	}
+
+	void fw_add(int i, int v) {
+		if (fw.empty()) return;
+		for (++i; i < (int)fw.size(); i += i & -i) fw[i] += v;
+	}
 };
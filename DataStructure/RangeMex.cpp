@@ -0,0 +1,117 @@
+// mex(A[l, r)) をたくさん答える。
+// 値 v ごとに「最後に出てきた位置」を持つセグ木を右端で走査し、last[v] < l となる最小の v を二分探索する。
+// 長さ len の区間の mex は len 以下なので、N より大きい値や負の値は無視してよい。
+
+#include <vector>
+#include <utility>
+
+using namespace std;
+
+// オフライン, O((N + Q) log N)
+vector<int> RangeMexOffline(const vector<int>& A, const vector<pair<int, int>>& query) {
+	int N = (int)A.size(), Q = (int)query.size();
+	int sz = 1;
+	while (sz < N + 1) sz <<= 1;
+	vector<int> last(sz << 1, -1); // 区間内の最後の出現位置の min
+
+	// 右端でバケットソート
+	vector<int> start(N + 2, 0), ord(Q);
+	for (const auto& [l, r] : query) start[r + 1]++;
+	for (int i = 0; i <= N; ++i) start[i + 1] += start[i];
+	for (int i = 0; i < Q; ++i) ord[start[query[i].second]++] = i;
+
+	vector<int> res(Q);
+	int qi = 0;
+	for (int r = 0; r <= N; ++r) {
+		if (r > 0 && 0 <= A[r - 1] && A[r - 1] <= N) {
+			int i = A[r - 1] + sz;
+			last[i] = r - 1;
+			for (i >>= 1; i; i >>= 1) last[i] = min(last[i << 1], last[i << 1 | 1]);
+		}
+		for (; qi < Q && query[ord[qi]].second == r; ++qi) {
+			int l = query[ord[qi]].first, i = 1;
+			while (i < sz) i = (last[i << 1] < l ? i << 1 : i << 1 | 1);
+			res[ord[qi]] = i - sz;
+		}
+	}
+	return res;
+}
+
+// オンライン, 永続セグ木。前処理 O(N log N), クエリ O(log N)
+class PersistentRangeMex {
+	int N, sz;
+	vector<int> lc, rc, last; // ノード 0 は全部 -1 の空の木
+	vector<int> root; // root[r] := A[0, r) を入れた版
+
+public:
+	PersistentRangeMex(const vector<int>& A) : N((int)A.size()), sz(1), lc(1, 0), rc(1, 0), last(1, -1), root(N + 1, 0) {
+		while (sz < N + 1) sz <<= 1;
+		int lg = 0;
+		while ((1 << lg) < sz) ++lg;
+		lc.reserve(1 + (size_t)N * (lg + 1));
+		rc.reserve(lc.capacity());
+		last.reserve(lc.capacity());
+		for (int r = 0; r < N; ++r) {
+			root[r + 1] = (0 <= A[r] && A[r] <= N) ? update(root[r], 0, sz, A[r], r) : root[r];
+		}
+	}
+
+	int operator()(int l, int r) const {
+		int v = root[r], lo = 0, w = sz;
+		while (w > 1) {
+			w >>= 1;
+			if (last[lc[v]] < l) v = lc[v];
+			else v = rc[v], lo += w;
+		}
+		return lo;
+	}
+
+private:
+	int update(int v, int lo, int w, int x, int pos) {
+		int nv = (int)last.size();
+		lc.push_back(lc[v]), rc.push_back(rc[v]), last.push_back(pos);
+		if (w == 1) return nv;
+		w >>= 1;
+		if (x < lo + w) {
+			int c = update(lc[v], lo, w, x, pos);
+			lc[nv] = c;
+		}
+		else {
+			int c = update(rc[v], lo + w, w, x, pos);
+			rc[nv] = c;
+		}
+		last[nv] = min(last[lc[nv]], last[rc[nv]]);
+		return nv;
+	}
+};
+
+//#include <random>
+//#include <iostream>
+//#include "Mex.cpp"
+//
+//// 区間ごとに Mex を作り直す愚直と比較
+//int main() {
+//	mt19937 rng(0);
+//	for (int t = 0; t < 100; ++t) {
+//		int N = rng() % 200 + 1, Q = 1000;
+//		vector<int> A(N);
+//		for (int& a : A) a = (int)(rng() % (N + 3)) - 1;
+//		vector<pair<int, int>> query(Q);
+//		for (auto& [l, r] : query) {
+//			l = rng() % (N + 1), r = rng() % (N + 1);
+//			if (l > r) swap(l, r);
+//		}
+//		vector<int> off = RangeMexOffline(A, query);
+//		PersistentRangeMex on(A);
+//		for (int i = 0; i < Q; ++i) {
+//			auto [l, r] = query[i];
+//			Mex mex(N);
+//			for (int j = l; j < r; ++j) mex.insert(A[j]);
+//			if (off[i] != mex() || on(l, r) != mex()) {
+//				cout << "wrong answer" << endl;
+//				return 0;
+//			}
+//		}
+//	}
+//	cout << "RangeMex seems to be fine!" << endl;
+//}
@@ -232,16 +232,18 @@ void RangeReverseTest() {
 	int N = 10;
 	SplayArray<string, op_str, e_str> sp(N);
 	rep(i, N) sp.set(i, string(1, '0' + i));
-	rep(j, N)
-		cout << sp.get(j) << " "; cout << endl;
+	rep(j, N) cout << sp.get(j) << " ";
+	cout << endl;
 	int W = 5;
 	for (int i = 0; i < N - W + 1; ++i) {
 		sp.reverse(i, i + W);
-		rep(j, N) cout << sp.get(j) << " "; cout << " : " << sp.prod(3, 7) << endl;
+		rep(j, N) cout << sp.get(j) << " ";
+		cout << " : " << sp.prod(3, 7) << endl;
 	}
 	for (int i = N - W; i >= 0; --i) {
 		sp.shift(i, i + W, 3);
-		rep(j, N) cout << sp.get(j) << " "; cout << " : " << sp.prod(3, 7) << endl;
+		rep(j, N) cout << sp.get(j) << " ";
+		cout << " : " << sp.prod(3, 7) << endl;
 	}
 }
 
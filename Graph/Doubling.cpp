@@ -1,44 +1,233 @@
 ﻿#include <vector>
 #include <functional>
+#include <bit>
+#include <cassert>
+#include <thread>
+#include <type_traits>
+#include <stdexcept>
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
 using namespace std;
 
+// 既知のモノイド。S が算術型ならこれを渡すと構築が SIMD gather になる
+enum class DoublingOp { Custom, Sum, Min, Max, Xor };
+
 template<typename S>
 class Doubling {
 private:
-	int N;
-	vector<int> G;
+	int N, LOG; // k < 2^LOG まで答えられる
 	vector<S> value;
 	function<S(S, S)> op;
-	vector<vector<S>> dp;
-	vector<vector<int>> nx;
+	vector<S> dp; // dp[p * N + i]
+	vector<int> nx; // nx[p * N + i]
 
 public:
-	Doubling(int N, const vector<int>& G, const vector<S>& value, function<S(S, S)> op)
-		: N(N), G(G), value(value), op(op)
+	// threads: 各段の構築を何スレッドで分けるか
+	Doubling(int N, const vector<int>& G, const vector<S>& value, function<S(S, S)> op, unsigned long long max_k = ~0ull, int threads = 1)
+		: N(N), LOG(max(1, (int)bit_width(max_k))), value(value), op(op), dp((size_t)LOG * N), nx((size_t)LOG * N)
 	{
-		nx.resize(64, vector<int>(N));
-		dp.resize(64, vector<S>(N));
-		for (int i = 0; i < N; ++i) {
-			nx[0][i] = G[i];
-			dp[0][i] = value[G[i]];
-		}
-		for (int p = 1; p < 64; ++p) {
-			for (int i = 0; i < N; ++i) {
-				nx[p][i] = nx[p - 1][nx[p - 1][i]];
-				dp[p][i] = op(dp[p - 1][i], dp[p - 1][nx[p - 1][i]]); // 指数が小さい方が左
-			}
-		}
+		build(G, DoublingOp::Custom, threads);
+	}
+
+	// S は算術型。Custom と、整数でない型の Xor は invalid_argument
+	Doubling(int N, const vector<int>& G, const vector<S>& value, DoublingOp kind, unsigned long long max_k = ~0ull, int threads = 1)
+		: N(N), LOG(max(1, (int)bit_width(max_k))), value(value), op(make_op(kind)), dp((size_t)LOG * N), nx((size_t)LOG * N)
+	{
+		static_assert(is_arithmetic_v<S>, "DoublingOp は算術型のときだけ。それ以外は op を渡す");
+		build(G, kind, threads);
 	}
 
 	S prod(int s, unsigned long long k) const {
+		assert(LOG == 64 || k >> LOG == 0);
 		S res = value[s];
 		int v = s;
-		for (int p = 0; p < 64; ++p) {
+		for (int p = 0; p < LOG; ++p) {
 			if (k >> p & 1) {
-				res = op(res, dp[p][v]); // 指数が小さい方が左
-				v = nx[p][v];
+				res = op(res, dp[(size_t)p * N + v]); // 指数が小さい方が左
+				v = nx[(size_t)p * N + v];
 			}
 		}
 		return res;
 	}
-};
\ No newline at end of file
+
+	// クエリ (s, k) をまとめて処理する。レベルごとに全クエリを進めるので、各レベルの表は一度しか舐めない
+	vector<S> prod_batch(const vector<pair<int, unsigned long long>>& query) const {
+		int Q = (int)query.size();
+		vector<S> res(Q);
+		vector<int> v(Q);
+		for (int i = 0; i < Q; ++i) {
+			assert(LOG == 64 || query[i].second >> LOG == 0);
+			v[i] = query[i].first;
+			res[i] = value[v[i]];
+		}
+		for (int p = 0; p < LOG; ++p) {
+			const int* cnx = &nx[(size_t)p * N];
+			const S* cdp = &dp[(size_t)p * N];
+			for (int i = 0; i < Q; ++i) {
+				if (query[i].second >> p & 1) {
+					res[i] = op(res[i], cdp[v[i]]);
+					v[i] = cnx[v[i]];
+				}
+			}
+		}
+		return res;
+	}
+
+private:
+	void build(const vector<int>& G, DoublingOp kind, int threads) {
+		for (int i = 0; i < N; ++i) {
+			nx[i] = G[i];
+			dp[i] = value[G[i]];
+		}
+		for (int p = 1; p < LOG; ++p) {
+			const int* pnx = &nx[(size_t)(p - 1) * N];
+			const S* pdp = &dp[(size_t)(p - 1) * N];
+			int* cnx = &nx[(size_t)p * N];
+			S* cdp = &dp[(size_t)p * N];
+			// 各段は前の段からの独立な gather なので、区間に分けて並列にできる
+			parallel_for(threads, [&](int lo, int hi) {
+				if constexpr (is_arithmetic_v<S>) {
+					switch (arithmetic_op(kind)) {
+					case DoublingOp::Sum: return level<DoublingOp::Sum>(pnx, pdp, cnx, cdp, lo, hi);
+					case DoublingOp::Min: return level<DoublingOp::Min>(pnx, pdp, cnx, cdp, lo, hi);
+					case DoublingOp::Max: return level<DoublingOp::Max>(pnx, pdp, cnx, cdp, lo, hi);
+					case DoublingOp::Xor:
+						if constexpr (is_integral_v<S>) return level<DoublingOp::Xor>(pnx, pdp, cnx, cdp, lo, hi);
+						break;
+					default: break;
+					}
+				}
+				for (int i = lo; i < hi; ++i) {
+					cnx[i] = pnx[pnx[i]];
+					cdp[i] = op(pdp[i], pdp[pnx[i]]); // 指数が小さい方が左
+				}
+			});
+		}
+	}
+
+	template<class F>
+	void parallel_for(int threads, const F& f) const {
+		threads = max(1, min(threads, N / (1 << 14)));
+		if (threads == 1) return f(0, N);
+		vector<thread> th;
+		for (int t = 1; t < threads; ++t) th.emplace_back(f, (int)((long long)N * t / threads), (int)((long long)N * (t + 1) / threads));
+		f(0, (int)((long long)N / threads));
+		for (thread& t : th) t.join();
+	}
+
+	static DoublingOp arithmetic_op(DoublingOp kind) {
+		if (!is_arithmetic_v<S>) return DoublingOp::Custom;
+		if (kind == DoublingOp::Xor && !is_integral_v<S>) return DoublingOp::Custom;
+		return kind;
+	}
+
+	template<DoublingOp K>
+	static S apply(S a, S b) {
+		static_assert(is_arithmetic_v<S>);
+		if constexpr (K == DoublingOp::Sum) return a + b;
+		else if constexpr (K == DoublingOp::Min) return b < a ? b : a;
+		else if constexpr (K == DoublingOp::Max) return a < b ? b : a;
+		else {
+			static_assert(K == DoublingOp::Xor && is_integral_v<S>);
+			return a ^ b;
+		}
+	}
+
+	static function<S(S, S)> make_op(DoublingOp kind) {
+		if constexpr (is_arithmetic_v<S>) {
+			switch (kind) {
+			case DoublingOp::Sum: return apply<DoublingOp::Sum>;
+			case DoublingOp::Min: return apply<DoublingOp::Min>;
+			case DoublingOp::Max: return apply<DoublingOp::Max>;
+			case DoublingOp::Xor:
+				if constexpr (is_integral_v<S>) return apply<DoublingOp::Xor>;
+				break;
+			default: break;
+			}
+		}
+		throw invalid_argument("Doubling: DoublingOp::Custom と整数でない型の Xor は op を渡すコンストラクタを使う");
+	}
+
+	template<DoublingOp K>
+	static void level(const int* pnx, const S* pdp, int* cnx, S* cdp, int lo, int hi) {
+		int i = lo;
+#if defined(__AVX512F__)
+		if constexpr (is_integral_v<S> && sizeof(S) == 4) {
+			for (; i + 16 <= hi; i += 16) {
+				__m512i idx = _mm512_loadu_si512(pnx + i);
+				_mm512_storeu_si512(cnx + i, _mm512_i32gather_epi32(idx, pnx, 4));
+				__m512i a = _mm512_loadu_si512(pdp + i), b = _mm512_i32gather_epi32(idx, pdp, 4);
+				_mm512_storeu_si512(cdp + i, vop512<K>(a, b));
+			}
+		}
+		else if constexpr (is_integral_v<S> && sizeof(S) == 8) {
+			for (; i + 8 <= hi; i += 8) {
+				__m256i idx = _mm256_loadu_si256((const __m256i*)(pnx + i));
+				_mm256_storeu_si256((__m256i*)(cnx + i), _mm256_i32gather_epi32(pnx, idx, 4));
+				__m512i a = _mm512_loadu_si512(pdp + i), b = _mm512_i32gather_epi64(idx, pdp, 8);
+				_mm512_storeu_si512(cdp + i, vop512<K>(a, b));
+			}
+		}
+#elif defined(__AVX2__)
+		if constexpr (is_integral_v<S> && sizeof(S) == 4) {
+			for (; i + 8 <= hi; i += 8) {
+				__m256i idx = _mm256_loadu_si256((const __m256i*)(pnx + i));
+				_mm256_storeu_si256((__m256i*)(cnx + i), _mm256_i32gather_epi32(pnx, idx, 4));
+				__m256i a = _mm256_loadu_si256((const __m256i*)(pdp + i));
+				__m256i b = _mm256_i32gather_epi32((const int*)pdp, idx, 4);
+				_mm256_storeu_si256((__m256i*)(cdp + i), vop256<K>(a, b));
+			}
+		}
+		else if constexpr (is_integral_v<S> && sizeof(S) == 8 && (is_signed_v<S> || K == DoublingOp::Sum || K == DoublingOp::Xor)) {
+			for (; i + 4 <= hi; i += 4) {
+				__m128i idx = _mm_loadu_si128((const __m128i*)(pnx + i));
+				_mm_storeu_si128((__m128i*)(cnx + i), _mm_i32gather_epi32(pnx, idx, 4));
+				__m256i a = _mm256_loadu_si256((const __m256i*)(pdp + i));
+				__m256i b = _mm256_i32gather_epi64((const long long*)pdp, idx, 8);
+				_mm256_storeu_si256((__m256i*)(cdp + i), vop256<K>(a, b));
+			}
+		}
+#endif
+		for (; i < hi; ++i) {
+			int j = pnx[i];
+			cnx[i] = pnx[j];
+			cdp[i] = apply<K>(pdp[i], pdp[j]);
+		}
+	}
+
+#if defined(__AVX512F__)
+	template<DoublingOp K>
+	static __m512i vop512(__m512i a, __m512i b) {
+		if constexpr (sizeof(S) == 4) {
+			if constexpr (K == DoublingOp::Sum) return _mm512_add_epi32(a, b);
+			else if constexpr (K == DoublingOp::Min) return is_signed_v<S> ? _mm512_min_epi32(a, b) : _mm512_min_epu32(a, b);
+			else if constexpr (K == DoublingOp::Max) return is_signed_v<S> ? _mm512_max_epi32(a, b) : _mm512_max_epu32(a, b);
+			else return _mm512_xor_si512(a, b);
+		}
+		else {
+			if constexpr (K == DoublingOp::Sum) return _mm512_add_epi64(a, b);
+			else if constexpr (K == DoublingOp::Min) return is_signed_v<S> ? _mm512_min_epi64(a, b) : _mm512_min_epu64(a, b);
+			else if constexpr (K == DoublingOp::Max) return is_signed_v<S> ? _mm512_max_epi64(a, b) : _mm512_max_epu64(a, b);
+			else return _mm512_xor_si512(a, b);
+		}
+	}
+#elif defined(__AVX2__)
+	template<DoublingOp K>
+	static __m256i vop256(__m256i a, __m256i b) {
+		if constexpr (sizeof(S) == 4) {
+			if constexpr (K == DoublingOp::Sum) return _mm256_add_epi32(a, b);
+			else if constexpr (K == DoublingOp::Min) return is_signed_v<S> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+			else if constexpr (K == DoublingOp::Max) return is_signed_v<S> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+			else return _mm256_xor_si256(a, b);
+		}
+		else {
+			// 64bit の min / max は AVX2 に無いので比較して blend (符号付きのみ)
+			if constexpr (K == DoublingOp::Sum) return _mm256_add_epi64(a, b);
+			else if constexpr (K == DoublingOp::Min) return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+			else if constexpr (K == DoublingOp::Max) return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(b, a));
+			else return _mm256_xor_si256(a, b);
+		}
+	}
+#endif
+};
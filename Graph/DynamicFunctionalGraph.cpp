@@ -0,0 +1,169 @@
+// 行き先 G[v] を書き換えられる関数グラフ。
+// 各連結成分を「根 r から出る 1 本 (r -> G[r]) を除いた根付き木」として link-cut tree で持つ。
+// サイクルは G[r] から r までのパスと、その辺 r -> G[r]。
+// Set, 各クエリともならし O(log N)
+
+#include <vector>
+#include <array>
+
+using namespace std;
+
+class DynamicFunctionalGraph {
+private:
+	int N;
+	vector<int> G;
+	vector<int> par, sz; // splay 木の親 (パスの親も兼ねる) と部分木サイズ
+	vector<array<int, 2>> ch;
+
+public:
+	DynamicFunctionalGraph(const vector<int>& A) : N((int)A.size()), G(N), par(N, -1), sz(N, 1), ch(N, { -1, -1 }) {
+		for (int v = 0; v < N; ++v) G[v] = v;
+		for (int v = 0; v < N; ++v) Set(v, A[v]);
+	}
+
+	int operator[](int v) const { return G[v]; }
+
+	// G[v] = to
+	void Set(int v, int to) {
+		int r = FindRoot(v);
+		if (r != v) {
+			Cut(v);
+			// サイクルが v から出る辺を通っていたなら、r が G[r] の下にぶら下がる
+			if (FindRoot(G[r]) == v) Link(r, G[r]);
+		}
+		G[v] = to;
+		if (FindRoot(to) != v) Link(v, to);
+	}
+
+	// 連結成分の代表 (木の根の頂点番号)。FunctionalGraph と違って 0, 1, ... の連番ではない
+	int ClusterID(int v) { return FindRoot(v); }
+	// returns the closest vertex id on the closest cycle
+	int ClosestCycle(int v) { return Lca(v, G[FindRoot(v)]); }
+	bool OnCycle(int v) { return ClosestCycle(v) == v; }
+	int DistToCycle(int v) { return Depth(v) - Depth(ClosestCycle(v)); }
+	int CycleSize(int v) { return Depth(G[FindRoot(v)]) + 1; }
+
+	int Move(int v, unsigned long long k) {
+		int c = G[FindRoot(v)], u = Lca(v, c);
+		int dv = Depth(v), du = Depth(u);
+		if (k <= (unsigned long long)(dv - du)) return AtDepth(v, dv - (int)k);
+		// サイクル上では深さが 1 ずつ減り、根の次は深さ L - 1 の c に戻る
+		long long L = Depth(c) + 1;
+		long long d = ((du - (long long)((k - (dv - du)) % L)) % L + L) % L;
+		return AtDepth(c, (int)d);
+	}
+
+private:
+	int size(int x) const { return x == -1 ? 0 : sz[x]; }
+	void update(int x) { sz[x] = size(ch[x][0]) + size(ch[x][1]) + 1; }
+	bool is_root(int x) const { return par[x] == -1 || (ch[par[x]][0] != x && ch[par[x]][1] != x); }
+
+	void rotate(int x) {
+		int y = par[x], z = par[y], d = (ch[y][1] == x);
+		if (!is_root(y)) ch[z][ch[z][1] == y] = x;
+		par[x] = z;
+		ch[y][d] = ch[x][d ^ 1];
+		if (ch[y][d] != -1) par[ch[y][d]] = y;
+		ch[x][d ^ 1] = y;
+		par[y] = x;
+		update(y), update(x);
+	}
+
+	void splay(int x) {
+		while (!is_root(x)) {
+			int y = par[x];
+			if (!is_root(y)) rotate((ch[y][1] == x) == (ch[par[y]][1] == y) ? y : x);
+			rotate(x);
+		}
+	}
+
+	// x から根までを一本のパスにする。最後につなぎ替えた頂点を返す
+	int access(int x) {
+		int last = -1;
+		for (int y = x; y != -1; y = par[y]) {
+			splay(y);
+			ch[y][1] = last;
+			update(y);
+			last = y;
+		}
+		splay(x);
+		return last;
+	}
+
+	int FindRoot(int x) {
+		access(x);
+		while (ch[x][0] != -1) x = ch[x][0];
+		splay(x);
+		return x;
+	}
+
+	int Depth(int x) {
+		access(x);
+		return size(ch[x][0]);
+	}
+
+	// 同じ木にあること
+	int Lca(int u, int v) {
+		access(u);
+		return access(v);
+	}
+
+	// x から根へのパス上で深さ d の頂点
+	int AtDepth(int x, int d) {
+		access(x);
+		while (true) {
+			int ls = size(ch[x][0]);
+			if (d < ls) x = ch[x][0];
+			else if (d == ls) break;
+			else d -= ls + 1, x = ch[x][1];
+		}
+		splay(x);
+		return x;
+	}
+
+	// x は根, y は別の木
+	void Link(int x, int y) {
+		access(x);
+		par[x] = y;
+	}
+
+	void Cut(int x) {
+		access(x);
+		par[ch[x][0]] = -1;
+		ch[x][0] = -1;
+		update(x);
+	}
+};
+
+//#include <random>
+//#include <chrono>
+//#include <iostream>
+//#include "FunctionalGraph.cpp"
+//
+//// 10^6 回の更新とクエリ。作り直す方は 100 回だけやって 10^6 回分に換算する
+//int main() {
+//	const int N = 100000, Q = 1000000;
+//	mt19937 rng(0);
+//	vector<int> A(N);
+//	for (int& a : A) a = rng() % N;
+//
+//	auto start = chrono::steady_clock::now();
+//	DynamicFunctionalGraph dg(A);
+//	long long sum = 0;
+//	for (int q = 0; q < Q; ++q) {
+//		int v = rng() % N;
+//		if (q & 1) dg.Set(v, rng() % N);
+//		else sum += dg.Move(v, rng()) + dg.DistToCycle(v);
+//	}
+//	double dyn = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+//
+//	start = chrono::steady_clock::now();
+//	for (int q = 0; q < 100; ++q) {
+//		A[rng() % N] = rng() % N;
+//		FunctionalGraph fg(A);
+//		int v = rng() % N;
+//		sum += fg.Move(v, rng()) + fg.DistToCycle(v);
+//	}
+//	double rebuild = chrono::duration<double>(chrono::steady_clock::now() - start).count() * (Q / 2 / 100);
+//	cout << "DynamicFunctionalGraph: " << dyn << " s, rebuild: " << rebuild << " s (" << sum << ")" << endl;
+//}
@@ -1,21 +1,46 @@
+#pragma once
+
 #include <vector>
-#include <queue>
+#include <span>
 #include <string>
+#include <thread>
+#include <atomic>
 using namespace std;
 
 class FunctionalGraph {
 private:
-	vector<int> G;
-	vector<vector<int>> H;
+	// 入力を持つか、外 (mmap など) のメモリを見るだけか。コピーしたときに自分の方を指し直す
+	struct Successor {
+		vector<int> own;
+		span<const int> a;
+		Successor(const vector<int>& A) : own(A), a(own) {}
+		Successor(span<const int> A) : a(A) {}
+		Successor(const Successor& o) : own(o.own), a(o.own.empty() ? o.a : span<const int>(own)) {}
+		Successor& operator=(const Successor& o) {
+			own = o.own;
+			a = o.own.empty() ? o.a : span<const int>(own);
+			return *this;
+		}
+		int operator[](int v) const { return a[v]; }
+	};
+
+	Successor G;
+	vector<int> H, H_start; // 逆辺の CSR。H[H_start[v], H_start[v + 1]) が v に入ってくる頂点
 	int N;
 	vector<vector<int>> cycles;
 	vector<int> dist_to_cycles;
 	vector<int> closest_v_on_cycle; // returns id of a vertex on a cycle.
 	vector<int> cluster;
-	vector<vector<int>> dp;
+	vector<int> cycle_pos; // 頂点がサイクル上で何番目か
+	vector<int> in, ord, head; // サイクルから生えた木の HLD
+	vector<vector<int>> dp; // use_doubling のときだけ作る
 
 public:
-	FunctionalGraph(vector<int>& A) : G(A), N((int)A.size()) { Init(); }
+	// A はコピーして持つ。threads > 1 ならサイクル検出をポインタジャンプで並列に行う
+	FunctionalGraph(const vector<int>& A, bool use_doubling = false, int threads = 1) : G(A), N((int)A.size()) { Init(use_doubling, threads); }
+
+	// A はコピーせずに見るだけ (mmap した巨大な入力など)。A は返り値より長く生きている必要がある
+	static FunctionalGraph View(span<const int> A, bool use_doubling = false, int threads = 1) { return FunctionalGraph(A, use_doubling, threads); }
 
 	// obsolate
 	int MoveSingle(int v, unsigned long long k) const {
@@ -30,9 +55,17 @@ public:
 		return v;
 	}
 
+	// 木の部分は HLD で k 個上の祖先、サイクルに入ったら位置を周期で割る。O(log N)
 	int Move(int v, unsigned long long k) const {
-		for (int i = 0; i < 64; ++i) if (k >> i & 1) v = dp[i][v];
-		return v;
+		if (!dp.empty()) {
+			for (int i = 0; i < 64; ++i) if (k >> i & 1) v = dp[i][v];
+			return v;
+		}
+		int d = dist_to_cycles[v];
+		if (k <= (unsigned long long)d) return KthAncestor(v, (int)k);
+		const vector<int>& C = cycles[cluster[v]];
+		unsigned long long L = C.size();
+		return C[(cycle_pos[closest_v_on_cycle[v]] + (k - d) % L) % L];
 	}
 
 	// still O(log N), but for fairly large numbers (ABC 030 D)
@@ -54,7 +87,7 @@ public:
 		}
 	}
 
-	int operator[](int v) { return G[v]; }
+	int operator[](int v) const { return G[v]; }
 
 	int ClusterID(int v) const { return cluster[v]; }
 	// returns the closest vertex id on the closest cycle
@@ -63,84 +96,195 @@ public:
 	int DistToCycle(int v) const { return dist_to_cycles[v]; }
 	const vector<int>& DistToCycle() const { return dist_to_cycles; }
 	const vector<vector<int>>& Cycles() const { return cycles; }
+	// サイクル上の頂点の、Cycles()[ClusterID(v)] での位置。サイクル上に無ければ -1
+	int CyclePos(int v) const { return cycle_pos[v]; }
+
+	// サイクル上の頂点を根とする木の HLD。heavy path は根側から HLDIndex が連続していて、先頭は HLDHead
+	int HLDIndex(int v) const { return in[v]; }
+	int HLDVertex(int t) const { return ord[t]; }
+	int HLDHead(int v) const { return head[v]; }
 
 private:
-	void Init() {
+	FunctionalGraph(span<const int> A, bool use_doubling, int threads) : G(A), N((int)A.size()) { Init(use_doubling, threads); }
+
+	void Init(bool use_doubling, int threads) {
+		CalcReverse();
+		vector<int> order; // BFS 順。HLD でも使う
+		if (threads > 1) {
+			CalcCyclesParallel(threads);
+			CalcCyclesInfo(order, false);
+			CalcCyclesOrder(threads);
+		}
+		else {
+			CalcCycles();
+			CalcCyclesInfo(order, true);
+		}
+		CalcLevelAncestor(order);
+		if (use_doubling) CalcDoubling();
+	}
+
+	// v から k 回進んだ頂点。k <= DistToCycle(v) のときだけ
+	int KthAncestor(int v, int k) const {
+		while (true) {
+			int u = head[v];
+			if (in[u] + k <= in[v]) return ord[in[v] - k];
+			k -= in[v] - in[u] + 1;
+			v = G[u];
+		}
+	}
+
+	template<class F>
+	void ParallelFor(int threads, const F& f) const {
+		vector<thread> th;
+		for (int t = 1; t < threads; ++t) th.emplace_back(f, (int)((long long)N * t / threads), (int)((long long)N * (t + 1) / threads));
+		f(0, (int)((long long)N / threads));
+		for (thread& t : th) t.join();
+	}
+
+	void CalcReverse() {
+		H_start.assign(N + 1, 0);
 		H.resize(N);
-		for (int i = 0; i < N; ++i) H[G[i]].emplace_back(i);
-		CalcCycles();
-		CalcCyclesInfo();
-		CalcCluster();
-		CalcDoubling();
+		for (int i = 0; i < N; ++i) H_start[G[i] + 1]++;
+		for (int i = 0; i < N; ++i) H_start[i + 1] += H_start[i];
+		for (int i = 0; i < N; ++i) H[H_start[G[i]]++] = i;
+		for (int i = N; i > 0; --i) H_start[i] = H_start[i - 1];
+		H_start[0] = 0;
 	}
 
+	// 0: 未訪問, 1: 今たどっている途中, 2: サイクルでない
+	// 各サイクルはその連結成分の最小の頂点から見つかり、そこからたどって最初に入る頂点が先頭になる
 	void CalcCycles() {
-		vector<int> seen(N, -1);
-		vector<bool> pushed(N, false);
-
+		cycle_pos.assign(N, -1);
+		vector<unsigned char> state(N, 0);
 		for (int i = 0; i < N; ++i) {
 			int v = i;
-			while (true) {
-				seen[v] = i;
+			while (state[v] == 0) {
+				state[v] = 1;
 				v = G[v];
-				if (seen[v] != -1) break;
 			}
-			if (seen[v] != i || pushed[v]) continue;
+			if (state[v] == 1) {
+				cycles.emplace_back();
+				int s = v;
+				do {
+					cycle_pos[v] = (int)cycles.back().size();
+					cycles.back().emplace_back(v);
+					v = G[v];
+				} while (v != s);
+			}
+			for (v = i; state[v] == 1; v = G[v]) state[v] = 2;
+		}
+	}
+
+	// J = G^(2^ceil(log N)) をポインタジャンプで作ると、その像がちょうどサイクル上の頂点。O(N log N) の仕事を並列に
+	void CalcCyclesParallel(int threads) {
+		vector<int> J(N), J2(N);
+		for (int i = 0; i < N; ++i) J[i] = G[i];
+		for (long long w = 1; w < N; w <<= 1) {
+			ParallelFor(threads, [&](int lo, int hi) { for (int i = lo; i < hi; ++i) J2[i] = J[J[i]]; });
+			swap(J, J2);
+		}
+		vector<int>().swap(J2);
+		cycle_pos.assign(N, -1);
+		ParallelFor(threads, [&](int lo, int hi) {
+			for (int i = lo; i < hi; ++i) atomic_ref<int>(cycle_pos[J[i]]).store(0, memory_order_relaxed);
+		});
+	}
+
+	// 並列版では cluster の番号を逐次版と同じにするため、BFS の後で連結成分の最小頂点の順にサイクルを並べる
+	void CalcCyclesOrder(int threads) {
+		vector<int> cycle_id(N, -1);
+		for (int i = 0; i < N; ++i) {
+			int s = closest_v_on_cycle[i];
+			if (cycle_id[s] != -1) continue;
+			int id = (int)cycles.size();
 			cycles.emplace_back();
-			int s = v;
-			while (true) {
+			int v = s;
+			do {
+				cycle_id[v] = id;
+				cycle_pos[v] = (int)cycles.back().size();
 				cycles.back().emplace_back(v);
-				pushed[v] = true;
 				v = G[v];
-				if (v == s) break;
-			}
+			} while (v != s);
 		}
+		cluster.resize(N);
+		ParallelFor(threads, [&](int lo, int hi) { for (int i = lo; i < hi; ++i) cluster[i] = cycle_id[closest_v_on_cycle[i]]; });
 	}
 
-	// calc dist_to_cycles and closest_cycle
-	void CalcCyclesInfo() {
+	// dist_to_cycles, closest_v_on_cycle, (with_cluster なら) cluster を一回の BFS でまとめて計算する
+	void CalcCyclesInfo(vector<int>& order, bool with_cluster) {
 		dist_to_cycles.assign(N, -1);
 		closest_v_on_cycle.assign(N, -1);
-		queue<int> que;
-		for (vector<int>& C : cycles) {
-			for (int v : C) {
-				dist_to_cycles[v] = 0;
-				closest_v_on_cycle[v] = v;
-				que.emplace(v);
+		if (with_cluster) cluster.assign(N, -1);
+		order.clear();
+		order.reserve(N);
+		if (with_cluster) {
+			for (int i = 0; i < (int)cycles.size(); ++i) {
+				for (int v : cycles[i]) {
+					cluster[v] = i;
+					order.emplace_back(v);
+				}
 			}
 		}
-		while (!que.empty()) {
-			int v = que.front(); que.pop();
-			for (int n : H[v]) {
+		else {
+			for (int v = 0; v < N; ++v) if (cycle_pos[v] != -1) order.emplace_back(v);
+		}
+		for (int v : order) {
+			dist_to_cycles[v] = 0;
+			closest_v_on_cycle[v] = v;
+		}
+		for (int i = 0; i < (int)order.size(); ++i) {
+			int v = order[i];
+			for (int j = H_start[v]; j < H_start[v + 1]; ++j) {
+				int n = H[j];
 				if (dist_to_cycles[n] != -1) continue;
 				dist_to_cycles[n] = dist_to_cycles[v] + 1;
 				closest_v_on_cycle[n] = closest_v_on_cycle[v];
-				que.push(n);
+				if (with_cluster) cluster[n] = cluster[v];
+				order.emplace_back(n);
 			}
 		}
 	}
 
-	void CalcCluster() {
-		cluster.assign(N, -1);
-		queue<int> que;
-		for (int i = 0; i < (int)cycles.size(); ++i) {
-			for (int v : cycles[i]) {
-				cluster[v] = i;
-				que.emplace(v);
-			}
+	// サイクル上の頂点を根とする木を HLD する。heavy path 上では in が連続する
+	void CalcLevelAncestor(const vector<int>& order) {
+		vector<int> sz(N, 1), heavy(N, -1);
+		for (int i = N - 1; i >= 0; --i) {
+			int v = order[i];
+			if (dist_to_cycles[v] == 0) continue;
+			sz[G[v]] += sz[v];
+			if (heavy[G[v]] == -1 || sz[heavy[G[v]]] < sz[v]) heavy[G[v]] = v;
 		}
-		while (!que.empty()) {
-			int v = que.front(); que.pop();
-			for (int n : H[v]) {
-				if (cluster[n] != -1) continue;
-				cluster[n] = cluster[v];
-				que.push(n);
+
+		in.assign(N, -1);
+		ord.assign(N, -1);
+		head.assign(N, -1);
+		int t = 0;
+		vector<int> st;
+		for (vector<int>& C : cycles) {
+			for (int r : C) {
+				head[r] = r;
+				st.emplace_back(r);
+				while (!st.empty()) {
+					int v = st.back(); st.pop_back();
+					in[v] = t, ord[t] = v, ++t;
+					for (int j = H_start[v]; j < H_start[v + 1]; ++j) {
+						int n = H[j];
+						if (dist_to_cycles[n] == 0 || n == heavy[v]) continue;
+						head[n] = n;
+						st.emplace_back(n);
+					}
+					if (heavy[v] != -1) {
+						head[heavy[v]] = head[v];
+						st.emplace_back(heavy[v]);
+					}
+				}
 			}
 		}
 	}
+
 	void CalcDoubling() {
 		dp.resize(64);
-		dp[0] = G;
+		dp[0].assign(G.a.begin(), G.a.end());
 		for (int i = 0; i < 63; ++i) {
 			dp[i + 1].resize(N);
 			for (int j = 0; j < N; ++j) dp[i + 1][j] = dp[i][dp[i][j]];
@@ -0,0 +1,149 @@
+// 関数グラフ上の半群積 prod(s, k) = value[s] op value[G[s]] op ... op value[G^k[s]] を O(N) メモリで答える。
+// Doubling::prod と同じ値を返すが、O(N log K) の表を持たない。
+//
+// サイクル, cluster, サイクルから生えた木の HLD は FunctionalGraph のものを使い、heavy path の先頭までの積 up[v] を持つ。
+// 途中で終わる heavy path と、サイクル上の区間 (2 周分並べたもの) はセグ木で取る。
+// op は結合的でさえあればよい (min のような逆元の無いものも可)。
+// 前処理 O(N), クエリ O(log N + log (K / サイクル長))
+
+#include <vector>
+#include <functional>
+#include "FunctionalGraph.cpp"
+
+using namespace std;
+
+template<typename S>
+class FunctionalGraphProd {
+private:
+	int N;
+	FunctionalGraph fg;
+	vector<S> value;
+	function<S(S, S)> op;
+	S e;
+
+	vector<S> up; // up[v] := value[v] op ... op value[head[v]]
+	vector<int> cyc_base; // サイクル c を 2 周分並べた区間の先頭
+
+	int data_size;
+	vector<S> data; // SegTree と同じく op(右, 左) で持つ。添字の大きい方から進む向きになるように並べる
+
+public:
+	FunctionalGraphProd(const vector<int>& G, const vector<S>& value, function<S(S, S)> op, S e)
+		: N((int)G.size()), fg(G), value(value), op(op), e(e) { build(); }
+
+	S prod(int s, unsigned long long k) const {
+		int d = fg.DistToCycle(s);
+		if (k <= (unsigned long long)d) return climb(s, (int)k + 1);
+
+		S res = climb(s, d + 1);
+		int r = fg.ClosestCycle(s), c = fg.ClusterID(r);
+		unsigned long long L = fg.Cycles()[c].size(), m = k - d;
+		int t0 = (fg.CyclePos(r) + 1) % (int)L;
+		if (m >= L) res = op(res, power(rotation(c, t0, (int)L), m / L));
+		if (m % L) res = op(res, rotation(c, t0, (int)(m % L)));
+		return res;
+	}
+
+	int DistToCycle(int v) const { return fg.DistToCycle(v); }
+	int ClosestCycle(int v) const { return fg.ClosestCycle(v); }
+
+private:
+	// v から親方向に need 頂点分の積
+	S climb(int v, int need) const {
+		S res = e;
+		while (true) {
+			int h = fg.HLDHead(v), len = fg.DistToCycle(v) - fg.DistToCycle(h) + 1;
+			if (need < len) return op(res, seg_prod(fg.HLDIndex(v) - need + 1, fg.HLDIndex(v) + 1));
+			res = op(res, up[v]);
+			need -= len;
+			if (need == 0) return res;
+			v = fg[h];
+		}
+	}
+
+	// サイクル c の位置 t0 から cnt (<= 長さ) 頂点分の積
+	S rotation(int c, int t0, int cnt) const {
+		int end = cyc_base[c] + 2 * (int)fg.Cycles()[c].size() - t0;
+		return seg_prod(end - cnt, end);
+	}
+
+	S power(S x, unsigned long long n) const {
+		S res = e;
+		for (; n; n >>= 1, x = op(x, x)) if (n & 1) res = op(res, x);
+		return res;
+	}
+
+	// a[r - 1] op ... op a[l]
+	S seg_prod(int l, int r) const {
+		S res_l = e, res_r = e;
+		l += data_size, r += data_size;
+		while (l < r) {
+			if (l & 1) res_l = op(data[l++], res_l);
+			if (r & 1) res_r = op(res_r, data[--r]);
+			l >>= 1, r >>= 1;
+		}
+		return op(res_r, res_l);
+	}
+
+	void build() {
+		// HLD の順では heavy path 上の親 (行き先) が先に来る
+		up.assign(N, e);
+		for (int t = 0; t < N; ++t) {
+			int v = fg.HLDVertex(t);
+			up[v] = (fg.HLDHead(v) == v ? value[v] : op(value[v], up[fg[v]]));
+		}
+
+		int M = N;
+		for (const vector<int>& C : fg.Cycles()) {
+			cyc_base.emplace_back(M);
+			M += 2 * (int)C.size();
+		}
+
+		// 木の部分は HLD の順、サイクルは 2 周分を逆順に並べる
+		data_size = 1;
+		while (data_size < M) data_size <<= 1;
+		data.assign(data_size << 1, e);
+		for (int v = 0; v < N; ++v) data[data_size + fg.HLDIndex(v)] = value[v];
+		for (int c = 0; c < (int)fg.Cycles().size(); ++c) {
+			const vector<int>& C = fg.Cycles()[c];
+			int L = (int)C.size(), b = cyc_base[c] + 2 * L - 1;
+			for (int p = 0; p < L; ++p) {
+				data[data_size + b - p] = value[C[p]];
+				data[data_size + b - p - L] = value[C[p]];
+			}
+		}
+		for (int i = data_size - 1; i >= 1; --i) data[i] = op(data[i << 1 | 1], data[i << 1]);
+	}
+};
+
+//#include <random>
+//#include <iostream>
+//#include "Doubling.cpp"
+//
+//// Doubling と比較。op は非可換なもの (一次関数の合成) と min
+//int main() {
+//	using P = pair<unsigned long long, unsigned long long>;
+//	mt19937_64 rng(0);
+//	for (int t = 0; t < 100; ++t) {
+//		int N = rng() % 300 + 1;
+//		vector<int> G(N);
+//		vector<P> val(N);
+//		for (int i = 0; i < N; ++i) G[i] = rng() % N, val[i] = { rng(), rng() };
+//		auto op = [](P a, P b) { return P{ a.first * b.first, a.second * b.first + b.second }; };
+//		Doubling<P> db(N, G, val, op);
+//		FunctionalGraphProd<P> fg(G, val, op, P{ 1, 0 });
+//		vector<unsigned long long> mn(N);
+//		for (auto& x : mn) x = rng();
+//		Doubling<unsigned long long> db_min(N, G, mn, DoublingOp::Min);
+//		FunctionalGraphProd<unsigned long long> fg_min(G, mn, [](auto a, auto b) { return min(a, b); }, ~0ull);
+//		for (int q = 0; q < 1000; ++q) {
+//			int s = rng() % N;
+//			unsigned long long k = (q & 1) ? rng() : rng() % (2 * N);
+//			if (db.prod(s, k) != fg.prod(s, k) || db_min.prod(s, k) != fg_min.prod(s, k)) {
+//				cout << "wrong answer" << endl;
+//				return 0;
+//			}
+//		}
+//	}
+//	cout << "FunctionalGraphProd seems to be fine!" << endl;
+//}
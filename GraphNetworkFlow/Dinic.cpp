@@ -1,3 +1,5 @@
+#pragma once
+
 // Dinic based max flow
 // https://github.com/drken1215/algorithm/blob/master/GraphNetworkFlow/max_flow_dinic.cpp
 //
@@ -8,6 +10,10 @@
 #include <iostream>
 #include <queue>
 #include <vector>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <sstream>
 using namespace std;
 
 template<class FLOWTYPE>
@@ -33,21 +39,89 @@ protected:
 	void init(int N = 0) {
 		G.assign(N, FlowEdge<FLOWTYPE>());
 		pos.clear();
+		synced = false;
+	}
+
+	// flow() で使う、詰めた辺の配列。v から出る辺は arc[arc_start[v], arc_start[v + 1]) で G[v] と同じ順。
+	// from, icap, flow は G の方にだけ持つ。
+	// 辺を足すまで (synced の間) は作り直さず、G とは change_edge と thaw で揃える
+	struct Arc {
+		int to, rev;
+		FLOWTYPE cap;
+	};
+	vector<Arc> arc;
+	vector<int> arc_start;
+	bool synced = false;
+	vector<int> touched; // flow() の中で容量を変えた辺。thaw でここだけ書き戻す
+	vector<char> dirty;
+
+	int rev_index(const FlowEdge<FLOWTYPE>& e) const { return e.from != e.to ? e.rev : e.rev + 1; }
+	FlowEdge<FLOWTYPE>& get_rev_edge(const FlowEdge<FLOWTYPE>& e) { return G[e.to][rev_index(e)]; }
+
+	// G から詰めた形を作る。G を頭から舐めるだけ
+	void freeze() {
+		if (synced) return;
+		synced = true;
+		int n = (int)G.size();
+		arc_start.assign(n + 1, 0);
+		for (int v = 0; v < n; ++v) arc_start[v + 1] = arc_start[v] + (int)G[v].size();
+		arc.resize(arc_start[n]);
+		for (int v = 0; v < n; ++v) {
+			for (int j = 0; j < (int)G[v].size(); ++j) {
+				const FlowEdge<FLOWTYPE>& e = G[v][j];
+				// 自己ループは順辺 j と逆辺 j + 1 が並んでいて、順辺の rev が自分を指している
+				int rj = (e.from == e.to && e.rev == j) ? j + 1 : e.rev;
+				arc[arc_start[v] + j] = { e.to, arc_start[e.to] + rj, e.cap };
+			}
+		}
+		touched.clear();
+		dirty.assign(arc.size(), 0);
 	}
 
-	FlowEdge<FLOWTYPE>& get_rev_edge(const FlowEdge<FLOWTYPE>& e) {
-		if (e.from != e.to) return G[e.to][e.rev];
-		else return G[e.to][e.rev + 1];
+	void push(int i, FLOWTYPE f) {
+		arc[i].cap -= f;
+		arc[arc[i].rev].cap += f;
+		if (!dirty[i]) dirty[i] = 1, touched.emplace_back(i);
+	}
+
+	// 残余容量を G に書き戻す。push で触った辺が少なければそこだけ。push を通さずに arc を書き換えたなら all
+	void thaw(bool all = false) {
+		if (!all && touched.size() * 8 < arc.size()) {
+			for (int i : touched) {
+				dirty[i] = 0;
+				for (int k : { i, arc[i].rev }) {
+					int v = arc[arc[k].rev].to;
+					FlowEdge<FLOWTYPE>& e = G[v][k - arc_start[v]];
+					e.cap = arc[k].cap, e.flow = e.icap - e.cap;
+				}
+			}
+			touched.clear();
+			return;
+		}
+		for (int v = 0; v < (int)G.size(); ++v) {
+			for (int j = 0; j < (int)G[v].size(); ++j) {
+				FlowEdge<FLOWTYPE>& e = G[v][j];
+				e.cap = arc[arc_start[v] + j].cap, e.flow = e.icap - e.cap;
+			}
+		}
+		for (int i : touched) dirty[i] = 0;
+		touched.clear();
 	}
 
 public:
-	vector<FlowEdge<FLOWTYPE>>& operator[](int i) { return G[i]; }
+	vector<FlowEdge<FLOWTYPE>>& operator[](int i) { synced = false; return G[i]; }
 	const vector<FlowEdge<FLOWTYPE>>& operator[](int i) const { return G[i]; }
 	size_t size() const { return G.size(); }
 
+	int edge_count() const { return (int)pos.size(); }
 	const FlowEdge<FLOWTYPE>& get_edge(int i) const {
 		return G[pos[i].first][pos[i].second];
 	}
+	// i 番目の辺の流量を f にする (容量はそのまま)
+	void set_flow(int i, FLOWTYPE f) {
+		FlowEdge<FLOWTYPE>& e = G[pos[i].first][pos[i].second];
+		change_edge(e, e.icap, f);
+	}
 	vector<FlowEdge<FLOWTYPE>> get_edges() const {
 		vector<FlowEdge<FLOWTYPE>> edges;
 		for (int i = 0; i < (int)pos.size(); ++i) {
@@ -59,17 +133,28 @@ public:
 		for (int i = 0; i < (int)G.size(); ++i) {
 			for (FlowEdge<FLOWTYPE>& e : G[i]) e.reset();
 		}
+		if (!synced) return;
+		for (int i = 0; i < (int)G.size(); ++i) {
+			for (int j = 0; j < (int)G[i].size(); ++j) arc[arc_start[i] + j].cap = G[i][j].cap;
+		}
+		for (int i : touched) dirty[i] = 0;
+		touched.clear();
 	}
 	void change_edge(FlowEdge<FLOWTYPE>& e, FLOWTYPE new_cap, FLOWTYPE new_flow) {
 		FlowEdge<FLOWTYPE>& re = get_rev_edge(e);
 		e.cap = new_cap - new_flow, e.icap = new_cap, e.flow = new_flow;
-		re.cap = new_flow;
+		re.cap = new_flow, re.flow = -new_flow;
+		if (synced) {
+			int i = arc_start[e.from] + (int)(&e - G[e.from].data());
+			arc[i].cap = e.cap, arc[arc[i].rev].cap = re.cap;
+		}
 	}
 
 	void add_edge(int from, int to, FLOWTYPE cap) {
 		pos.emplace_back(from, (int)G[from].size());
 		G[from].emplace_back((int)G[to].size(), from, to, cap);
 		G[to].emplace_back((int)G[from].size() - 1, to, from, 0);
+		synced = false;
 	}
 
 	friend ostream& operator<<(ostream& os, const FlowGraph& G) {
@@ -79,60 +164,288 @@ public:
 	}
 };
 
+// DinicGraph<FLOWTYPE, true> のときだけ集める統計。1 phase は BFS 1 回とその後の DFS。
+// 最後の t に届かなかった BFS も length = -1 の phase として数える
 template<class FLOWTYPE>
+struct DinicStats {
+	struct Phase {
+		int length = -1; // レベルグラフでの t の深さ
+		FLOWTYPE flow = 0;
+		long long augmentations = 0, edge_scans = 0, dead_ends = 0;
+		double bfs_sec = 0, dfs_sec = 0;
+	};
+	vector<Phase> phases;
+	long long augmentations = 0, edge_scans = 0, dead_ends = 0;
+	double bfs_sec = 0, dfs_sec = 0;
+
+	void add(const Phase& p) {
+		phases.emplace_back(p);
+		augmentations += p.augmentations, edge_scans += p.edge_scans, dead_ends += p.dead_ends;
+		bfs_sec += p.bfs_sec, dfs_sec += p.dfs_sec;
+	}
+
+	string to_json() const {
+		ostringstream os;
+		os << "{\"phases\":" << phases.size() << ",\"augmentations\":" << augmentations << ",\"edge_scans\":" << edge_scans
+			<< ",\"dead_ends\":" << dead_ends << ",\"bfs_sec\":" << bfs_sec << ",\"dfs_sec\":" << dfs_sec << ",\"phase\":[";
+		for (int i = 0; i < (int)phases.size(); ++i) {
+			const Phase& p = phases[i];
+			os << (i ? "," : "") << "{\"length\":" << p.length << ",\"flow\":" << p.flow << ",\"augmentations\":" << p.augmentations
+				<< ",\"edge_scans\":" << p.edge_scans << ",\"dead_ends\":" << p.dead_ends
+				<< ",\"bfs_sec\":" << p.bfs_sec << ",\"dfs_sec\":" << p.dfs_sec << "}";
+		}
+		os << "]}";
+		return os.str();
+	}
+};
+
+// STATS = true なら phase ごとの統計を取る。false のときは数えるコードごと消える
+template<class FLOWTYPE, bool STATS = false>
 class DinicGraph : public FlowGraph<FLOWTYPE> {
 private:
+	using Phase = typename DinicStats<FLOWTYPE>::Phase;
 	int s, t;
-	vector<int> level, iter;
+	vector<int> level, iter, path, que;
+	FLOWTYPE delta = 0; // スケーリング中は残余容量が delta 以上の辺だけ使う
+	DinicStats<FLOWTYPE> stat;
+	Phase cur;
+	function<void(const Phase&)> phase_callback;
 public:
 	DinicGraph(int N, int s, int t) : FlowGraph<FLOWTYPE>(N), s(s), t(t), level(N, -1), iter(N, 0) {}
+
+	const DinicStats<FLOWTYPE>& stats() const {
+		static_assert(STATS, "use DinicGraph<FLOWTYPE, true>");
+		return stat;
+	}
+	void clear_stats() { stat = DinicStats<FLOWTYPE>(); }
+	// phase が終わるたびに呼ばれる
+	void on_phase(function<void(const Phase&)> f) {
+		static_assert(STATS, "use DinicGraph<FLOWTYPE, true>");
+		phase_callback = f;
+	}
+	// reset() と合わせて、同じグラフで別の 2 点間に流し直すとき用
+	void set_terminals(int new_s, int new_t) { s = new_s, t = new_t; }
+	// 今の流量から続けて流す。change_capacity の後に呼べば、変えた分だけ流し直す
 	FLOWTYPE flow(FLOWTYPE flow_limit = numeric_limits<FLOWTYPE>::max()) {
+		this->freeze();
+		FLOWTYPE current_flow = augment(s, t, flow_limit);
+		this->thaw();
+		return current_flow;
+	}
+
+	// 容量スケーリング版。残余容量が delta 以上の辺だけで Dinic して、delta を半分ずつにしていく。
+	// 容量の幅が広い (1 から 10^15 など) ときに phase の数が減る。O(E^2 log U)
+	FLOWTYPE scaling_flow(FLOWTYPE flow_limit = numeric_limits<FLOWTYPE>::max()) {
+		this->freeze();
+		FLOWTYPE max_cap = 0;
+		for (const auto& a : this->arc) max_cap = max(max_cap, a.cap);
+		delta = 1;
+		while (delta <= max_cap / 2) delta *= 2;
 		FLOWTYPE current_flow = 0;
+		for (; delta > 1 && current_flow < flow_limit; delta /= 2) current_flow += augment<true>(s, t, flow_limit - current_flow);
+		current_flow += augment(s, t, flow_limit - current_flow);
+		this->thaw();
+		return current_flow;
+	}
+
+	// i 番目の辺の容量を new_cap にして、今の流量をフローとして正しい状態に直す。
+	// 容量を減らして流量が new_cap を超えたら、超えた分を残余グラフで from -> to に迂回させ、
+	// 迂回できなかった分は from から s (か t) へ、s (か t) から to へ押し戻す。
+	// 返り値は s から出る流量の変化 (<= 0)。増やした容量の分は次の flow() で流れる
+	FLOWTYPE change_capacity(int i, FLOWTYPE new_cap) {
+		FlowEdge<FLOWTYPE>& e = this->G[this->pos[i].first][this->pos[i].second];
+		FLOWTYPE over = e.flow - new_cap;
+		int x = e.from, y = e.to;
+		if (over <= 0 || x == y) {
+			this->change_edge(e, new_cap, min(e.flow, new_cap));
+			return 0;
+		}
+		FLOWTYPE before = out_flow();
+		this->change_edge(e, new_cap, new_cap);
+		this->freeze();
+		over -= augment(x, y, over);
+		FLOWTYPE ex = (x == s || x == t) ? 0 : over, de = (y == s || y == t) ? 0 : over;
+		ex -= augment(x, s, ex);
+		augment(x, t, ex);
+		de -= augment(s, y, de);
+		augment(t, y, de);
+		this->thaw();
+		return out_flow() - before;
+	}
 
-		while (current_flow < flow_limit) {
-			bfs();
-			if (level[t] < 0) break;
-			iter.assign((int)iter.size(), 0);
-			while (current_flow < flow_limit) {
-				FLOWTYPE flow = dfs(s, flow_limit - current_flow);
-				if (!flow) break;
-				current_flow += flow;
+	// flow() の後、残余グラフで s から行ける頂点。s 側が true の最小カット
+	vector<bool> min_cut() const {
+		int n = (int)this->G.size();
+		vector<bool> res(n, false);
+		vector<int> st = { s };
+		res[s] = true;
+		while (!st.empty()) {
+			int v = st.back(); st.pop_back();
+			for (const FlowEdge<FLOWTYPE>& e : this->G[v]) {
+				if (e.cap > 0 && !res[e.to]) {
+					res[e.to] = true;
+					st.emplace_back(e.to);
+				}
 			}
 		}
-		return current_flow;
+		return res;
 	}
 
 private:
-	void bfs() {
+	FLOWTYPE out_flow() const {
+		FLOWTYPE res = 0;
+		for (const FlowEdge<FLOWTYPE>& e : this->G[s]) res += e.flow;
+		return res;
+	}
+
+	template<bool SCALING>
+	bool usable(FLOWTYPE cap) const {
+		if constexpr (SCALING) return cap >= delta;
+		else return cap > 0;
+	}
+
+	// 詰めた辺の上で src から dst へ limit まで流す
+	template<bool SCALING = false>
+	FLOWTYPE augment(int src, int dst, FLOWTYPE limit) {
+		using clock = chrono::steady_clock;
+		FLOWTYPE current_flow = 0;
+		while (current_flow < limit) {
+			clock::time_point t0;
+			if constexpr (STATS) cur = Phase(), t0 = clock::now();
+			bfs<SCALING>(src, dst);
+			if constexpr (STATS) {
+				cur.length = level[dst];
+				cur.bfs_sec = chrono::duration<double>(clock::now() - t0).count();
+				if (level[dst] < 0) record();
+			}
+			if (level[dst] < 0) break;
+			copy(this->arc_start.begin(), this->arc_start.end() - 1, iter.begin());
+			if constexpr (STATS) t0 = clock::now();
+			FLOWTYPE flow = dfs<SCALING>(src, dst, limit - current_flow);
+			if constexpr (STATS) {
+				cur.flow = flow;
+				cur.dfs_sec = chrono::duration<double>(clock::now() - t0).count();
+				record();
+			}
+			if (!flow) break;
+			current_flow += flow;
+		}
+		return current_flow;
+	}
+
+	void record() {
+		stat.add(cur);
+		if (phase_callback) phase_callback(cur);
+	}
+
+	template<bool SCALING>
+	void bfs(int s, int t) {
 		level.assign((int)this->G.size(), -1);
 		level[s] = 0;
-		queue<int> que; que.push(s);
-		while (!que.empty()) {
-			int v = que.front(); que.pop();
-			for (const FlowEdge<FLOWTYPE>& e : this->G[v]) {
-				if (level[e.to] < 0 && e.cap > 0) {
+		que.clear(); que.emplace_back(s);
+		for (int qi = 0; qi < (int)que.size(); ++qi) {
+			int v = que[qi];
+			for (int i = this->arc_start[v]; i < this->arc_start[v + 1]; ++i) {
+				const auto& e = this->arc[i];
+				if constexpr (STATS) ++cur.edge_scans;
+				if (level[e.to] < 0 && usable<SCALING>(e.cap)) {
 					level[e.to] = level[v] + 1;
 					if (e.to == t) return;
-					que.emplace(e.to);
+					que.emplace_back(e.to);
 				}
 			}
 		}
 	}
 
-	FLOWTYPE dfs(int v, FLOWTYPE up_flow) {
-		if (v == t) return up_flow;
+	// 明示的なスタックで増加路を探し、up_flow まで流す
+	template<bool SCALING>
+	FLOWTYPE dfs(int s, int t, FLOWTYPE up_flow) {
+		auto& arc = this->arc;
 		FLOWTYPE res_flow = 0;
-		for (int& i = iter[v]; i < (int)this->G[v].size(); ++i) {
-			FlowEdge<FLOWTYPE>& e = this->G[v][i];
-			FlowEdge<FLOWTYPE>& re = this->get_rev_edge(this->G[v][i]);
-			if (level[v] >= level[e.to] || e.cap == 0) continue;
-			FLOWTYPE flow = dfs(e.to, min(up_flow - res_flow, e.cap));
-			if (flow <= 0) continue;
-			res_flow += flow;
-			e.cap -= flow, e.flow += flow;
-			re.cap += flow, re.flow -= flow;
-			if (res_flow == up_flow) break;
+		path.clear();
+		int v = s;
+		while (res_flow < up_flow) {
+			if (v == t) {
+				FLOWTYPE flow = up_flow - res_flow;
+				for (int id : path) flow = min(flow, arc[id].cap);
+				int back = (int)path.size();
+				for (int i = 0; i < (int)path.size(); ++i) {
+					this->push(path[i], flow);
+					if (back == (int)path.size() && !usable<SCALING>(arc[path[i]].cap)) back = i;
+				}
+				res_flow += flow;
+				if constexpr (STATS) ++cur.augmentations;
+				// 最初に飽和した (使えなくなった) 辺の手前まで戻る
+				path.resize(back);
+				v = path.empty() ? s : arc[path.back()].to;
+				continue;
+			}
+			int& i = iter[v];
+			const int end = this->arc_start[v + 1];
+			[[maybe_unused]] int i0 = i;
+			while (i < end && (!usable<SCALING>(arc[i].cap) || level[v] >= level[arc[i].to])) ++i;
+			if constexpr (STATS) cur.edge_scans += i - i0 + (i < end);
+			if (i < end) {
+				path.emplace_back(i);
+				v = arc[i].to;
+			}
+			else {
+				if constexpr (STATS) ++cur.dead_ends;
+				if (v == s) break;
+				v = arc[arc[path.back()].rev].to;
+				path.pop_back();
+				++iter[v];
+			}
 		}
 		return res_flow;
-	};
+	}
 };
+
+//#include <random>
+//#include <cmath>
+//#include <tuple>
+//
+//// 容量が 1 から 10^15 まで散らばったグラフで flow と scaling_flow の phase 数, 増加路の数, 時間を比べる
+//int main() {
+//	mt19937_64 rng(0);
+//	auto wide = [&]() { return (long long)(rng() % 1000 + 1) * (long long)pow(10, rng() % 13); };
+//	auto bench = [&](string name, int N, int s, int t, const vector<tuple<int, int, long long>>& E) {
+//		DinicGraph<long long, true> a(N, s, t), b(N, s, t);
+//		for (auto [u, v, c] : E) a.add_edge(u, v, c), b.add_edge(u, v, c);
+//		auto start = chrono::steady_clock::now();
+//		long long f1 = a.flow();
+//		double t1 = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+//		start = chrono::steady_clock::now();
+//		long long f2 = b.scaling_flow();
+//		double t2 = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+//		cout << name << ": flow " << a.stats().phases.size() << " phases " << a.stats().augmentations << " paths " << t1 << " s, scaling_flow "
+//			<< b.stats().phases.size() << " phases " << b.stats().augmentations << " paths " << t2 << " s"
+//			<< (f1 == f2 ? "" : " (wrong answer)") << endl;
+//	};
+//	{
+//		int N = 20000, M = 200000;
+//		vector<tuple<int, int, long long>> E;
+//		for (int i = 0; i < M; ++i) E.emplace_back(rng() % N, rng() % N, wide());
+//		bench("random", N, 0, N - 1, E);
+//	}
+//	{
+//		int L = 100, W = 200, N = L * W + 2;
+//		vector<tuple<int, int, long long>> E;
+//		for (int w = 0; w < W; ++w) E.emplace_back(N - 2, w, wide()), E.emplace_back((L - 1) * W + w, N - 1, wide());
+//		for (int l = 0; l + 1 < L; ++l) for (int w = 0; w < W; ++w) {
+//			for (int k = 0; k < 4; ++k) E.emplace_back(l * W + w, (l + 1) * W + rng() % W, wide());
+//		}
+//		bench("layered", N, N - 2, N - 1, E);
+//	}
+//	{
+//		// 細長い層グラフ (戻る辺あり)。増加路が長く、ボトルネックの小さい路をたくさん流すことになる
+//		int L = 2000, W = 10, N = L * W + 2;
+//		vector<tuple<int, int, long long>> E;
+//		for (int w = 0; w < W; ++w) E.emplace_back(N - 2, w, (long long)1e15), E.emplace_back((L - 1) * W + w, N - 1, (long long)1e15);
+//		for (int l = 0; l + 1 < L; ++l) for (int w = 0; w < W; ++w) {
+//			for (int k = 0; k < 3; ++k) E.emplace_back(l * W + w, (l + 1) * W + rng() % W, wide());
+//		}
+//		for (int l = 1; l < L; ++l) for (int w = 0; w < W; ++w) if (rng() % 2) E.emplace_back(l * W + w, (l - 1) * W + rng() % W, wide());
+//		bench("deep", N, N - 2, N - 1, E);
+//	}
+//}
@@ -0,0 +1,165 @@
+#pragma once
+
+// Gomory-Hu tree (equivalent flow tree) による全点対最小カット
+// 無向グラフの辺を渡すと、N - 1 回の Dinic で木を作る。u-v の最小カットは木の u-v パス上の最小の重み。
+// Gusfield と同じく縮約はせず、元のグラフで頂点集合を最小カットで割っていく。
+// 割った後の集合どうしは独立なので、threads 本のスレッドがそれぞれ自分の DinicGraph を持って並列に流す。
+//
+// min_cut(u, v) は O(木の深さ)、all_pairs() は O(N^2) で表を作るのでその後は O(1)
+
+#include "Dinic.cpp"
+#include <tuple>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+template<class FLOWTYPE>
+class GomoryHuTree {
+private:
+	int N;
+	vector<tuple<int, int, FLOWTYPE>> E;
+	vector<tuple<int, int, FLOWTYPE>> tree;
+	vector<int> par, depth; // 0 を根にした木
+	vector<FLOWTYPE> weight; // weight[v] := v と par[v] の間の重み
+
+public:
+	// edges は無向辺 (u, v, cap)
+	GomoryHuTree(int N, const vector<tuple<int, int, FLOWTYPE>>& edges, int threads = 1) : N(N), E(edges) {
+		build(max(1, threads));
+		root();
+	}
+
+	// 木の辺 (u, v, u-v の最小カット)
+	const vector<tuple<int, int, FLOWTYPE>>& edges() const { return tree; }
+
+	FLOWTYPE min_cut(int u, int v) const {
+		FLOWTYPE res = numeric_limits<FLOWTYPE>::max();
+		while (u != v) {
+			if (depth[u] < depth[v]) swap(u, v);
+			res = min(res, weight[u]);
+			u = par[u];
+		}
+		return res;
+	}
+
+	// 各頂点から木を DFS する。res[u][u] は numeric_limits::max()
+	vector<vector<FLOWTYPE>> all_pairs() const {
+		vector<vector<pair<int, FLOWTYPE>>> T(N);
+		for (auto [u, v, w] : tree) T[u].emplace_back(v, w), T[v].emplace_back(u, w);
+		vector<vector<FLOWTYPE>> res(N, vector<FLOWTYPE>(N));
+		vector<int> st, from(N);
+		for (int r = 0; r < N; ++r) {
+			res[r][r] = numeric_limits<FLOWTYPE>::max();
+			from[r] = -1;
+			st.emplace_back(r);
+			while (!st.empty()) {
+				int v = st.back(); st.pop_back();
+				for (auto [u, w] : T[v]) {
+					if (u == from[v]) continue;
+					from[u] = v;
+					res[r][u] = min(res[r][v], w);
+					st.emplace_back(u);
+				}
+			}
+		}
+		return res;
+	}
+
+private:
+	// 集合 S から 2 点 s = S[0], t = S[1] を選んで最小カットで割る。割った集合を共有のキューに積む
+	void build(int threads) {
+		vector<vector<int>> tasks;
+		if (N >= 2) {
+			tasks.emplace_back(N);
+			for (int v = 0; v < N; ++v) tasks[0][v] = v;
+		}
+		int active = 0;
+		mutex mtx;
+		condition_variable cv;
+
+		auto worker = [&]() {
+			DinicGraph<FLOWTYPE> g(N, 0, 0);
+			for (auto [u, v, c] : E) g.add_edge(u, v, c), g.add_edge(v, u, c);
+			while (true) {
+				vector<int> S;
+				{
+					unique_lock<mutex> lk(mtx);
+					cv.wait(lk, [&] { return !tasks.empty() || active == 0; });
+					if (tasks.empty()) return;
+					S = move(tasks.back());
+					tasks.pop_back();
+					++active;
+				}
+				int s = S[0], t = S[1];
+				g.reset();
+				g.set_terminals(s, t);
+				FLOWTYPE f = g.flow();
+				vector<bool> cut = g.min_cut();
+				vector<int> A, B;
+				for (int v : S) (cut[v] ? A : B).emplace_back(v);
+				{
+					lock_guard<mutex> lk(mtx);
+					tree.emplace_back(s, t, f);
+					if (A.size() >= 2) tasks.emplace_back(move(A));
+					if (B.size() >= 2) tasks.emplace_back(move(B));
+					--active;
+				}
+				cv.notify_all();
+			}
+		};
+		vector<thread> th;
+		for (int i = 1; i < threads; ++i) th.emplace_back(worker);
+		worker();
+		for (thread& t : th) t.join();
+	}
+
+	void root() {
+		vector<vector<pair<int, FLOWTYPE>>> T(N);
+		for (auto [u, v, w] : tree) T[u].emplace_back(v, w), T[v].emplace_back(u, w);
+		par.assign(N, -1), depth.assign(N, 0), weight.assign(N, numeric_limits<FLOWTYPE>::max());
+		if (N == 0) return;
+		vector<int> st = { 0 };
+		while (!st.empty()) {
+			int v = st.back(); st.pop_back();
+			for (auto [u, w] : T[v]) {
+				if (u == par[v]) continue;
+				par[u] = v, depth[u] = depth[v] + 1, weight[u] = w;
+				st.emplace_back(u);
+			}
+		}
+	}
+};
+
+//#include <random>
+//#include <chrono>
+//
+//// 全点対で Dinic を流したものと比較して、スレッド数ごとの時間を測る
+//int main() {
+//	mt19937 rng(0);
+//	for (int it = 0; it < 300; ++it) {
+//		int N = rng() % 10 + 1, M = rng() % 30;
+//		vector<tuple<int, int, long long>> E;
+//		for (int i = 0; i < M; ++i) E.emplace_back(rng() % N, rng() % N, rng() % 10);
+//		GomoryHuTree<long long> gh(N, E, 1 + it % 4);
+//		auto table = gh.all_pairs();
+//		for (int u = 0; u < N; ++u) for (int v = u + 1; v < N; ++v) {
+//			DinicGraph<long long> g(N, u, v);
+//			for (auto [a, b, c] : E) g.add_edge(a, b, c), g.add_edge(b, a, c);
+//			long long f = g.flow();
+//			if (gh.min_cut(u, v) != f || table[u][v] != f || table[v][u] != f) {
+//				cout << "wrong answer" << endl;
+//				return 0;
+//			}
+//		}
+//	}
+//	cout << "GomoryHuTree seems to be fine!" << endl;
+//
+//	int N = 2000, M = 20000;
+//	vector<tuple<int, int, long long>> E;
+//	for (int i = 0; i < M; ++i) E.emplace_back(rng() % N, rng() % N, rng() % 100 + 1);
+//	for (int threads : { 1, 2, 4, 8 }) {
+//		auto start = chrono::steady_clock::now();
+//		GomoryHuTree<long long> gh(N, E, threads);
+//		cout << threads << " threads: " << chrono::duration<double>(chrono::steady_clock::now() - start).count() << " s" << endl;
+//	}
+//}
@@ -0,0 +1,200 @@
+#pragma once
+
+// Highest-Label Push-Relabel (HLPP) max flow
+// FlowGraph, FlowEdge は Dinic.cpp のものを使う。DinicGraph と同じように add_edge して flow() を呼び、get_edges() で流量が読める。
+// 大域的ラベル更新と gap を使う。O(V^2 √E)
+//
+// 一段階版: 高さを 2V まで許して、t に届かない超過は s に押し戻す。
+// なので flow() の後は各辺の流量もちゃんとしたフローになっている。
+
+#include "Dinic.cpp"
+
+template<class FLOWTYPE>
+class HLPPGraph : public FlowGraph<FLOWTYPE> {
+private:
+	int s, t, n;
+	vector<int> h, cur;
+	vector<FLOWTYPE> ex;
+	// act: 高さごとの超過のある頂点 (単方向リスト), all: 高さ < n の全頂点 (双方向リスト, gap 用)
+	vector<int> act_head, act_next, all_head, all_next, all_prev;
+	int hi, all_hi; // act / all で空でない最大の高さ
+	long long work;
+
+public:
+	HLPPGraph(int N, int s, int t) : FlowGraph<FLOWTYPE>(N), s(s), t(t), n(N) {}
+
+	FLOWTYPE flow() {
+		this->freeze();
+		auto& arc = this->arc;
+		h.assign(n, 0);
+		ex.assign(n, 0);
+		cur.assign(this->arc_start.begin(), this->arc_start.end() - 1);
+		act_next.assign(n, -1), all_next.assign(n, -1), all_prev.assign(n, -1);
+		for (int i = this->arc_start[s]; i < this->arc_start[s + 1]; ++i) {
+			FLOWTYPE f = arc[i].cap;
+			arc[i].cap -= f, arc[arc[i].rev].cap += f;
+			ex[s] -= f, ex[arc[i].to] += f;
+		}
+		global_relabel();
+
+		long long m = (long long)arc.size();
+		while (hi >= 0) {
+			int v = act_head[hi];
+			if (v == -1) {
+				--hi;
+				continue;
+			}
+			act_head[hi] = act_next[v];
+			discharge(v);
+			if (work > 6 * n + m) global_relabel();
+		}
+		this->thaw(true);
+		return ex[t];
+	}
+
+private:
+	void activate(int v) {
+		act_next[v] = act_head[h[v]];
+		act_head[h[v]] = v;
+		hi = max(hi, h[v]);
+	}
+	void all_insert(int v) {
+		int k = h[v];
+		all_prev[v] = -1, all_next[v] = all_head[k];
+		if (all_head[k] != -1) all_prev[all_head[k]] = v;
+		all_head[k] = v;
+		all_hi = max(all_hi, k);
+	}
+	void all_erase(int v) {
+		if (all_prev[v] != -1) all_next[all_prev[v]] = all_next[v];
+		else all_head[h[v]] = all_next[v];
+		if (all_next[v] != -1) all_prev[all_next[v]] = all_prev[v];
+	}
+
+	// 残余グラフで t への距離 (届かなければ n + s への距離) を高さにする
+	void global_relabel() {
+		auto& arc = this->arc;
+		const auto& start = this->arc_start;
+		work = 0;
+		h.assign(n, 2 * n);
+		vector<int> que;
+		que.reserve(n);
+		for (int root : { t, s }) {
+			h[root] = (root == t ? 0 : n);
+			que.emplace_back(root);
+			for (int qi = (int)que.size() - 1; qi < (int)que.size(); ++qi) {
+				int v = que[qi];
+				for (int i = start[v]; i < start[v + 1]; ++i) {
+					int u = arc[i].to;
+					if (h[u] == 2 * n && arc[arc[i].rev].cap > 0) {
+						h[u] = h[v] + 1;
+						que.emplace_back(u);
+					}
+				}
+			}
+		}
+		act_head.assign(2 * n, -1), all_head.assign(n, -1);
+		hi = all_hi = -1;
+		for (int v = 0; v < n; ++v) {
+			cur[v] = start[v];
+			if (h[v] < n) all_insert(v);
+			if (v != s && v != t && ex[v] > 0 && h[v] < 2 * n) activate(v);
+		}
+	}
+
+	void discharge(int v) {
+		auto& arc = this->arc;
+		while (ex[v] > 0) {
+			if (cur[v] == this->arc_start[v + 1]) {
+				if (!relabel(v)) return;
+				continue;
+			}
+			auto& e = arc[cur[v]];
+			if (e.cap > 0 && h[v] == h[e.to] + 1) {
+				FLOWTYPE f = min(ex[v], e.cap);
+				e.cap -= f, arc[e.rev].cap += f;
+				ex[v] -= f;
+				if (ex[e.to] == 0 && e.to != s && e.to != t) activate(e.to);
+				ex[e.to] += f;
+			}
+			else ++cur[v];
+		}
+	}
+
+	bool relabel(int v) {
+		auto& arc = this->arc;
+		int oh = h[v], nh = 2 * n;
+		for (int i = this->arc_start[v]; i < this->arc_start[v + 1]; ++i) {
+			if (arc[i].cap > 0) nh = min(nh, h[arc[i].to] + 1);
+		}
+		work += this->arc_start[v + 1] - this->arc_start[v] + 12;
+		cur[v] = this->arc_start[v];
+		if (oh < n) {
+			all_erase(v);
+			if (all_head[oh] == -1) {
+				// gap: oh より上で n 未満の頂点はもう t に届かない
+				for (int k = oh + 1; k <= all_hi; ++k) {
+					for (int u = all_head[k]; u != -1; u = all_next[u]) h[u] = n + 1;
+					all_head[k] = -1;
+					for (int u = act_head[k]; u != -1;) {
+						int nu = act_next[u];
+						activate(u);
+						u = nu;
+					}
+					act_head[k] = -1;
+				}
+				all_hi = oh - 1;
+				nh = max(nh, n + 1);
+			}
+		}
+		h[v] = nh;
+		if (nh >= 2 * n) return false;
+		if (nh < n) all_insert(v);
+		return true;
+	}
+};
+
+//#include <random>
+//#include <chrono>
+//
+//// grid, layered, random で Dinic と比較
+//int main() {
+//	mt19937 rng(0);
+//	auto bench = [&](string name, int N, int s, int t, const vector<tuple<int, int, long long>>& E) {
+//		DinicGraph<long long> dinic(N, s, t);
+//		HLPPGraph<long long> hlpp(N, s, t);
+//		for (auto [u, v, c] : E) dinic.add_edge(u, v, c), hlpp.add_edge(u, v, c);
+//		auto start = chrono::steady_clock::now();
+//		long long f1 = dinic.flow();
+//		double t1 = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+//		start = chrono::steady_clock::now();
+//		long long f2 = hlpp.flow();
+//		double t2 = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+//		cout << name << ": Dinic " << t1 << " s, HLPP " << t2 << " s" << (f1 == f2 ? "" : " (wrong answer)") << endl;
+//	};
+//	{
+//		int R = 500, C = 500;
+//		vector<tuple<int, int, long long>> E;
+//		for (int r = 0; r < R; ++r) for (int c = 0; c < C; ++c) {
+//			int v = r * C + c;
+//			if (c + 1 < C) E.emplace_back(v, v + 1, rng() % 100), E.emplace_back(v + 1, v, rng() % 100);
+//			if (r + 1 < R) E.emplace_back(v, v + C, rng() % 100), E.emplace_back(v + C, v, rng() % 100);
+//		}
+//		bench("grid", R * C, 0, R * C - 1, E);
+//	}
+//	{
+//		int L = 300, W = 300, N = L * W + 2;
+//		vector<tuple<int, int, long long>> E;
+//		for (int w = 0; w < W; ++w) E.emplace_back(N - 2, w, 100), E.emplace_back((L - 1) * W + w, N - 1, 100);
+//		for (int l = 0; l + 1 < L; ++l) for (int w = 0; w < W; ++w) {
+//			for (int k = 0; k < 5; ++k) E.emplace_back(l * W + w, (l + 1) * W + rng() % W, rng() % 10 + 1);
+//		}
+//		bench("layered", N, N - 2, N - 1, E);
+//	}
+//	{
+//		int N = 100000, M = 1000000;
+//		vector<tuple<int, int, long long>> E;
+//		for (int i = 0; i < M; ++i) E.emplace_back(rng() % N, rng() % N, rng() % 100 + 1);
+//		bench("random", N, 0, N - 1, E);
+//	}
+//}
@@ -3,6 +3,11 @@
 #include <iostream>
 #include <vector>
 #include <functional>
+#include <algorithm>
+#include <thread>
+#include <random>
+#include <chrono>
+#include <string>
 
 #include <atcoder/fenwicktree.hpp>
 #include <atcoder/modint.hpp>
@@ -40,7 +45,7 @@ namespace DoubleSigma {
 	// O(N * √maxA * log(maxA))
 	template<class T = long long>
 	T XmodY(const vector<T>& A) {
-		T max_a = *max_element(all(A));
+		T max_a = *max_element(A.begin(), A.end());
 		T sq_a = Sqrt(max_a);
 
 		vector<T> L(sq_a);
@@ -68,26 +73,65 @@ namespace DoubleSigma {
 		return ans;
 	}
 
-	// O(N + maxA * log(maxA))
-	template<class T = long long>
-	T FloorAllPairs(const vector<T>& A) {
-		const T max_a = *max_element(A.begin(), A.end());
-		vector<T> L(max_a + 1);
-		for(int i = 0; i < A.size(); ++i) L[A[i]] += 1;
-		for(int i = 0; i < max_a; ++i) L[i + 1] += L[i];
-		T ans = 0;
-		for (int a = 1; a <= max_a; ++a) {
-			int c = L[a] - L[a - 1];
-			if (c == 0) continue;
-			for (int k = a; k <= max_a; k += a) {
-				int l = min<int>(k + a - 1, max_a);
-				ans += c * T(k / a) * (L[l] - L[k - 1]);
+	// Σ_a w(a) * cnt(a) * Σ_x cnt(x) * floor(x / a) を調和級数のループで。L は値の個数の累積和
+	// a は threads 本に飛び飛びに配る (小さい a ほど重いので、区間で切ると偏る)
+	template<class T, class F>
+	T HarmonicFloorSum(const vector<T>& L, int max_a, int threads, const F& w) {
+		threads = max(1, threads);
+		vector<T> part(threads, 0);
+		auto run = [&](int t) {
+			T res = 0;
+			for (int a = 1 + t; a <= max_a; a += threads) {
+				T c = L[a] - L[a - 1];
+				if (c == 0) continue;
+				T s = 0;
+				for (int k = a; k <= max_a; k += a) {
+					int l = min(k + a - 1, max_a);
+					s += T(k / a) * (L[l] - L[k - 1]);
+				}
+				res += w(a) * c * s;
 			}
-		}
-		ans -= A.size();
+			part[t] = res;
+		};
+		vector<thread> th;
+		for (int t = 1; t < threads; ++t) th.emplace_back(run, t);
+		run(0);
+		for (thread& t : th) t.join();
+		T ans = 0;
+		for (const T& x : part) ans += x;
 		return ans;
 	}
 
+	template<class T>
+	vector<T> CountPrefix(const vector<T>& A, int max_a) {
+		vector<T> L(max_a + 1);
+		for (const T& a : A) L[a] += 1;
+		for (int i = 0; i < max_a; ++i) L[i + 1] += L[i];
+		return L;
+	}
+
+	// Σ_{i != j} floor(A_i / A_j)
+	// O(N + maxA * log(maxA))
+	template<class T = long long>
+	T FloorAllPairs(const vector<T>& A, int threads = 1) {
+		const int max_a = (int)*max_element(A.begin(), A.end());
+		vector<T> L = CountPrefix(A, max_a);
+		return HarmonicFloorSum(L, max_a, threads, [](int) { return T(1); }) - T(A.size());
+	}
+
+	// Σ_{i != j} A_i mod A_j = Σ_{i != j} (A_i - A_j * floor(A_i / A_j))
+	// 添字の順に依存しないので、個数の累積和だけで O(N + maxA * log(maxA))
+	template<class T = long long>
+	T XmodYAllPairs(const vector<T>& A, int threads = 1) {
+		const int max_a = (int)*max_element(A.begin(), A.end());
+		vector<T> L = CountPrefix(A, max_a);
+		T sum = 0;
+		for (const T& a : A) sum += a;
+		// i = j の項 (floor = 1) も入っているので sum を引く
+		T floor_sum = HarmonicFloorSum(L, max_a, threads, [](int a) { return T(a); }) - sum;
+		return T(A.size() - 1) * sum - floor_sum;
+	}
+
 	// O(N * √maxA * log(maxA))
 	template<class T = long long>
 	T FloorXoverY(const vector<T>& A) {
@@ -116,41 +160,322 @@ namespace DoubleSigma {
 		return ans;
 	}
 
+	// ここから値が大きい (10^12 など) とき用。メモリは O(N) で、maxA の大きさの配列は作らない。
+	// 値をソートして、floor(x / a) = q となる区間 [q a, (q + 1) a) のうち空でないものだけを二分探索で飛ぶ。
+	// a 1 つあたり O(min(N, maxA / a) log N)
+
+	// B: ソートした相異なる値, P: P[r] = (B[r] 未満の個数)。Σ_{r} w(B[r]) cnt(B[r]) Σ_x floor(x / B[r])
+	template<class T, class F>
+	T BlockFloorSum(const vector<T>& B, const vector<T>& P, const F& w) {
+		const int D = (int)B.size();
+		T ans = 0;
+		for (int r = 0; r < D; ++r) {
+			const T a = B[r];
+			T s = 0;
+			for (int p = r; p < D;) {
+				T q = B[p] / a;
+				int np = (int)(lower_bound(B.begin() + p, B.end(), (q + 1) * a) - B.begin());
+				s += q * (P[np] - P[p]);
+				p = np;
+			}
+			ans += w(a) * (P[r + 1] - P[r]) * s;
+		}
+		return ans;
+	}
+
+	template<class T>
+	void Compress(const vector<T>& A, vector<T>& B, vector<T>& P) {
+		B = A;
+		sort(B.begin(), B.end());
+		B.erase(unique(B.begin(), B.end()), B.end());
+		P.assign(B.size() + 1, 0);
+		for (const T& a : A) P[lower_bound(B.begin(), B.end(), a) - B.begin() + 1] += 1;
+		for (int i = 0; i < (int)B.size(); ++i) P[i + 1] += P[i];
+	}
+
+	// FloorAllPairs と同じ
+	template<class T = long long>
+	T FloorAllPairsLarge(const vector<T>& A) {
+		vector<T> B, P;
+		Compress(A, B, P);
+		return BlockFloorSum(B, P, [](const T&) { return T(1); }) - T(A.size());
+	}
+
+	// XmodYAllPairs と同じ
+	template<class T = long long>
+	T XmodYAllPairsLarge(const vector<T>& A) {
+		vector<T> B, P;
+		Compress(A, B, P);
+		T sum = 0;
+		for (const T& a : A) sum += a;
+		return T(A.size() - 1) * sum - (BlockFloorSum(B, P, [](const T& a) { return a; }) - sum);
+	}
+
+	// F[j] = Σ_{i<j} floor(A_i / A_j)。順番に入れながら、入れた値の個数を順位の fenwick tree で持つ。
+	// 小さい方から √N 個の相異なる値は区間が多いので、XmodY の L と同じく入れるたびに足しておく
+	template<class T>
+	vector<T> PrefixFloorSums(const vector<T>& A) {
+		const int N = (int)A.size();
+		vector<T> B = A;
+		sort(B.begin(), B.end());
+		B.erase(unique(B.begin(), B.end()), B.end());
+		const int D = (int)B.size();
+		const int K = min<int>(D, (int)Sqrt<long long>(N) + 1);
+
+		vector<T> L(K), F(N);
+		atcoder::fenwick_tree<T> ft(D);
+		for (int j = 0; j < N; ++j) {
+			const T a = A[j];
+			const int r = (int)(lower_bound(B.begin(), B.end(), a) - B.begin());
+			if (r < K) F[j] = L[r];
+			else {
+				for (int p = r; p < D;) {
+					T q = B[p] / a;
+					int np = (int)(lower_bound(B.begin() + p, B.end(), (q + 1) * a) - B.begin());
+					F[j] += q * ft.sum(p, np);
+					p = np;
+				}
+			}
+			ft.add(r, T(1));
+			for (int k = 0; k < K; ++k) L[k] += a / B[k];
+		}
+		return F;
+	}
+
+	// FloorXoverY と同じ
+	template<class T = long long>
+	T FloorXoverYLarge(const vector<T>& A) {
+		T ans = 0;
+		for (const T& f : PrefixFloorSums(A)) ans += f;
+		return ans;
+	}
+
+	// XmodY と同じ。Σ_{i<j} A_i mod A_j = Σ_{i<j} A_i - Σ_j A_j F[j]
+	template<class T = long long>
+	T XmodYLarge(const vector<T>& A) {
+		vector<T> F = PrefixFloorSums(A);
+		T ans = 0;
+		for (int j = 0; j < (int)A.size(); ++j) ans += T(A.size() - 1 - j) * A[j] - A[j] * F[j];
+		return ans;
+	}
+
+	// Σ_{i<j} lcm(A_i, A_j) = (Σ_g W(g) S(g)^2 - Σ A_i) / 2,  S(g) = Σ_{g | a} a,  Σ_{d | n} W(d) = 1 / n
+	// W(n) = Π_{p | n} (1 - p) / n は乗法的なので線形篩で、S は素数ごとの約数方向の累積和で作る。
+	// O(N + maxA log log maxA)。T は mod が maxA より大きい素数の modint
 	template<class T = atcoder::modint998244353>
 	T XlcmY(const vector<int>& A) {
-		int maxA = *max_element(all(A));
-		PrimeFactorization pf(maxA);
+		const int maxA = *max_element(A.begin(), A.end());
 
-		vector<long long> cnt(maxA + 1);
-		for (auto a : A) cnt[a] += 1;
+		vector<T> S(maxA + 1);
+		for (int a : A) S[a] += a;
 
+		// inv[i] = -(mod / i) * inv[mod % i]
 		vector<T> W(maxA + 1);
-		vector<T> inv(maxA + 1);
-		for (int i = 1; i <= maxA; ++i) inv[i] = T::raw(i).inv();
-		for (int i = 1; i <= maxA; ++i) {
-			auto D = pf.Divisors(i, false);
-			W[i] = inv[i];
-			for (auto d : D) if (i != d) {
-				W[i] -= W[d];
+		W[1] = 1;
+		for (int i = 2; i <= maxA; ++i) W[i] = -T(T::mod() / i) * W[T::mod() % i];
+
+		// g(n) = Π_{p | n} (1 - p) を掛ける
+		vector<int> primes;
+		vector<T> g(maxA + 1);
+		vector<bool> composite(maxA + 1, false);
+		g[1] = 1;
+		for (int i = 2; i <= maxA; ++i) {
+			if (!composite[i]) primes.emplace_back(i), g[i] = 1 - T(i);
+			for (int p : primes) {
+				if ((long long)i * p > maxA) break;
+				composite[i * p] = true;
+				if (i % p == 0) {
+					g[i * p] = g[i];
+					break;
+				}
+				g[i * p] = g[i] * (1 - T(p));
 			}
+			W[i] *= g[i];
+		}
+
+		for (int p : primes) {
+			for (int i = maxA / p; i >= 1; --i) S[i] += S[i * p];
 		}
 
 		T ans = 0;
-		for (int i = 1; i <= maxA; ++i) {
-			T s = 0;
-			for (int d = i; d <= maxA; d += i) {
-				s += cnt[d] * d;
-			}
-			ans += W[i] * s * s;
+		for (int i = 1; i <= maxA; ++i) ans += W[i] * S[i] * S[i];
+		for (int a : A) ans -= a;
+		ans *= (T(2).inv());
+
+		return ans;
+	}
+
+	// ここから対称な演算。Σ_{i<j} op(A_i, A_j) は添字の順によらない
+
+	// cnt[b] = (bit b が立っている個数)。bit ごとに全要素を舐めるループにしておくとベクトル化される
+	template<class T>
+	vector<long long> BitCounts(const vector<T>& A) {
+		vector<long long> cnt(64);
+		for (int b = 0; b < 64; ++b) {
+			long long c = 0;
+			for (const T& a : A) c += ((unsigned long long)a >> b) & 1;
+			cnt[b] = c;
 		}
-		for (int i = 0; i < A.size(); ++i) ans -= A[i];
-		ans *= inv[2];
+		return cnt;
+	}
+
+	// O(N log maxA)
+	template<class T = long long>
+	T XxorY(const vector<T>& A) {
+		vector<long long> cnt = BitCounts(A);
+		const long long N = A.size();
+		T ans = 0;
+		for (int b = 0; b < 64; ++b) ans += T(cnt[b] * (N - cnt[b])) << b;
+		return ans;
+	}
+
+	template<class T = long long>
+	T XandY(const vector<T>& A) {
+		vector<long long> cnt = BitCounts(A);
+		T ans = 0;
+		for (int b = 0; b < 64; ++b) ans += T(cnt[b] * (cnt[b] - 1) / 2) << b;
+		return ans;
+	}
+
+	template<class T = long long>
+	T XorY(const vector<T>& A) {
+		vector<long long> cnt = BitCounts(A);
+		const long long N = A.size();
+		T ans = 0;
+		for (int b = 0; b < 64; ++b) ans += T(N * (N - 1) / 2 - (N - cnt[b]) * (N - cnt[b] - 1) / 2) << b;
+		return ans;
+	}
+
+	// ソートして j 番目は j 個の値より大きい。O(N log N)
+	template<class T = long long>
+	T MaxXY(const vector<T>& A) {
+		vector<T> B = A;
+		sort(B.begin(), B.end());
+		T ans = 0;
+		for (int j = 0; j < (int)B.size(); ++j) ans += T(j) * B[j];
+		return ans;
+	}
 
+	template<class T = long long>
+	T MinXY(const vector<T>& A) {
+		vector<T> B = A;
+		sort(B.begin(), B.end());
+		T ans = 0;
+		for (int j = 0; j < (int)B.size(); ++j) ans += T(B.size() - 1 - j) * B[j];
+		return ans;
+	}
+
+	// |x - y| = max - min
+	template<class T = long long>
+	T AbsXminusY(const vector<T>& A) {
+		vector<T> B = A;
+		sort(B.begin(), B.end());
+		T ans = 0;
+		for (int j = 0; j < (int)B.size(); ++j) ans += (T(2 * j) - T(B.size() - 1)) * B[j];
 		return ans;
 	}
 
+	// gcd(x, y) = Σ_{d | gcd(x, y)} φ(d) なので、全順序対で Σ_d φ(d) cnt(d)^2 (cnt(d) は d の倍数の個数)。
+	// φ は線形篩、cnt は素数ごとの約数方向の累積和。O(N + maxA log log maxA)
+	template<class T = long long>
+	T XgcdY(const vector<T>& A) {
+		const int maxA = (int)*max_element(A.begin(), A.end());
+		vector<T> cnt(maxA + 1);
+		for (const T& a : A) cnt[a] += 1;
+
+		vector<int> primes, phi(maxA + 1);
+		phi[1] = 1;
+		for (int i = 2; i <= maxA; ++i) {
+			if (phi[i] == 0) primes.emplace_back(i), phi[i] = i - 1;
+			for (int p : primes) {
+				if ((long long)i * p > maxA) break;
+				if (i % p == 0) {
+					phi[i * p] = phi[i] * p;
+					break;
+				}
+				phi[i * p] = phi[i] * (p - 1);
+			}
+		}
+		for (int p : primes) {
+			for (int i = maxA / p; i >= 1; --i) cnt[i] += cnt[i * p];
+		}
+
+		T ans = 0;
+		for (int d = 1; d <= maxA; ++d) ans += T(phi[d]) * cnt[d] * cnt[d];
+		for (const T& a : A) ans -= a;
+		return ans / 2;
+	}
+
 } // namespace DoubleSigma
 
+// 値が [1, max_a] の多重集合に insert / erase しながら、相異なる 2 要素の順序対についての
+// Σ floor(x / y) と Σ x mod y を持ち続ける。FloorAllPairs, XmodYAllPairs を毎回呼ぶのと同じ値。
+// a が割る側: a < √maxA なら L[a] = Σ_x floor(x / j) を引くだけ、そうでなければ [k a, (k + 1) a) ごとに個数の fenwick tree で O(maxA / a log maxA)
+// a が割られる側: floor(a / y) が同じ y の区間は O(√a) 個なので、個数と値の和の fenwick tree を引く
+// 1 回 O(√maxA log maxA)
+template<class T = long long>
+class DoubleSigmaMultiset {
+private:
+	int max_a, sq_a;
+	vector<T> L;
+	atcoder::fenwick_tree<T> cnt, sum;
+	T n, total, floor_total, mod_total;
+
+public:
+	DoubleSigmaMultiset(int max_a) : max_a(max_a), sq_a((int)DoubleSigma::Sqrt<long long>(max_a)), L(sq_a), cnt(max_a + 1), sum(max_a + 1), n(0), total(0), floor_total(0), mod_total(0) {}
+
+	void insert(int a) {
+		update(a, T(1));
+		cnt.add(a, T(1)), sum.add(a, T(a));
+		for (int j = 1; j < sq_a; ++j) L[j] += a / j;
+		n += 1, total += a;
+	}
+
+	// a が入っていること
+	void erase(int a) {
+		cnt.add(a, T(-1)), sum.add(a, T(-a));
+		for (int j = 1; j < sq_a; ++j) L[j] -= a / j;
+		n -= 1, total -= a;
+		update(a, T(-1));
+	}
+
+	T size() const { return n; }
+	// Σ_{i != j} floor(A_i / A_j)
+	T floor_sum() const { return floor_total; }
+	// Σ_{i != j} A_i mod A_j
+	T mod_sum() const { return mod_total; }
+
+private:
+	// a 以外の要素との間の項を sign 倍して足す
+	void update(int a, T sign) {
+		// Σ_x floor(x / a)
+		// 区間は隣り合っているので、前の区間の右端の累積和を使い回す
+		T over = 0;
+		if (a < sq_a) over = L[a];
+		else {
+			T prev = cnt.sum(0, a);
+			for (int k = a; k <= max_a; k += a) {
+				T cur = cnt.sum(0, min(k + a, max_a + 1));
+				over += T(k / a) * (cur - prev);
+				prev = cur;
+			}
+		}
+		// Σ_y floor(a / y), Σ_y y floor(a / y)
+		T under = 0, under_w = 0, prev_c = 0, prev_s = 0;
+		for (int l = 1; l <= a;) {
+			int q = a / l, r = a / q;
+			T c = cnt.sum(0, r + 1), w = sum.sum(0, r + 1);
+			under += T(q) * (c - prev_c);
+			under_w += T(q) * (w - prev_s);
+			prev_c = c, prev_s = w;
+			l = r + 1;
+		}
+		floor_total += sign * (over + under);
+		// Σ_x (x - a floor(x / a)) + Σ_y (a - y floor(a / y))
+		mod_total += sign * (total - T(a) * over + T(a) * n - under_w);
+	}
+};
+
 template<typename T>
 class DoubleSigmaVerifier {
 	int NT, N;
@@ -197,14 +522,171 @@ public:
 		}
 		return res;
 	}
+
+	// BruteForce, BruteForceAllPairs をスレッドで割ったもの。N = 10^5 くらいまでなら答え合わせに使える。
+	// 列 j ごとに Σ_i op(A_i, A_j) を連続した i で回すので、op がインライン展開されてベクトル化されやすい。
+	// 列 j の重さは j に比例するので、スレッドには飛び飛びに配る
+	template<T(*op)(T, T)>
+	static T ParallelBruteForce(const vector<T>& A, int threads = (int)thread::hardware_concurrency()) {
+		return ParallelOracle<op, false>(A, threads);
+	}
+
+	template<T(*op)(T, T)>
+	static T ParallelBruteForceAllPairs(const vector<T>& A, int threads = (int)thread::hardware_concurrency()) {
+		return ParallelOracle<op, true>(A, threads);
+	}
+
+	using Generator = function<vector<T>(int, long long, mt19937_64&)>;
+
+	// 値が [1, max_a] の入力の作り方。一様以外は表の境界や同じ値の多い場合を狙う
+	static vector<pair<string, Generator>> generators() {
+		vector<pair<string, Generator>> res;
+		res.emplace_back("uniform", [](int N, long long max_a, mt19937_64& rng) {
+			vector<T> A(N);
+			for (auto& a : A) a = T(rng() % max_a + 1);
+			return A;
+		});
+		res.emplace_back("all equal", [](int N, long long max_a, mt19937_64& rng) {
+			return vector<T>(N, T(rng() % max_a + 1));
+		});
+		res.emplace_back("small", [](int N, long long max_a, mt19937_64& rng) {
+			vector<T> A(N);
+			for (auto& a : A) a = T(rng() % min(max_a, 16LL) + 1);
+			return A;
+		});
+		res.emplace_back("powers of two", [](int N, long long max_a, mt19937_64& rng) {
+			int lg = 0;
+			while ((2LL << lg) <= max_a) ++lg;
+			vector<T> A(N);
+			for (auto& a : A) a = T(1LL << (rng() % (lg + 1)));
+			return A;
+		});
+		res.emplace_back("near max", [](int N, long long max_a, mt19937_64& rng) {
+			vector<T> A(N);
+			for (auto& a : A) a = T(max(1LL, max_a - (long long)(rng() % 16)));
+			return A;
+		});
+		// 篩うのは 2^24 まで
+		res.emplace_back("primes", [](int N, long long max_a, mt19937_64& rng) {
+			const long long M = min(max_a, 1LL << 24);
+			vector<bool> composite(M + 1, false);
+			vector<long long> primes;
+			for (long long i = 2; i <= M; ++i) {
+				if (composite[i]) continue;
+				primes.emplace_back(i);
+				for (long long j = i * i; j <= M; j += i) composite[j] = true;
+			}
+			if (primes.empty()) primes.emplace_back(1);
+			vector<T> A(N);
+			for (auto& a : A) a = T(primes[rng() % primes.size()]);
+			return A;
+		});
+		return res;
+	}
+
+	// 各 generator で trials 回ずつ、長さ N, 値が [1, max_a] の入力で bf と f を比べて、それぞれの合計時間を出す。
+	// seed が同じなら同じ入力になる。違ったら generator と何回目かを出す (N が小さければ入力も)
+	static bool fuzz(function<T(const vector<T>&)> bf, function<T(const vector<T>&)> f, string f_name, int N, long long max_a, int trials = 1, unsigned long long seed = 0) {
+		bool ok = true;
+		for (auto& [g_name, gen] : generators()) {
+			mt19937_64 rng(seed);
+			double bf_sec = 0, f_sec = 0;
+			for (int it = 0; it < trials; ++it) {
+				vector<T> A = gen(N, max_a, rng);
+				auto start = chrono::steady_clock::now();
+				T expected = bf(A);
+				auto mid = chrono::steady_clock::now();
+				T actual = f(A);
+				auto end = chrono::steady_clock::now();
+				bf_sec += chrono::duration<double>(mid - start).count();
+				f_sec += chrono::duration<double>(end - mid).count();
+				if (expected != actual) {
+					cout << f_name << " differs on " << g_name << " (seed " << seed << ", trial " << it << ")" << endl;
+					if (N <= 100) {
+						for (auto a : A) cout << a << " ";
+						cout << endl;
+					}
+					ok = false;
+					break;
+				}
+			}
+			cout << f_name << " / " << g_name << ": oracle " << bf_sec << " s, kernel " << f_sec << " s" << endl;
+		}
+		return ok;
+	}
+
+private:
+	template<T(*op)(T, T), bool ALL>
+	static T ParallelOracle(const vector<T>& A, int threads) {
+		const int N = (int)A.size();
+		threads = max(1, threads);
+		vector<T> part(threads, 0);
+		auto run = [&](int t) {
+			const T* a = A.data();
+			T res = 0;
+			for (int j = t; j < N; j += threads) {
+				const T y = a[j];
+				T s = 0;
+				for (int i = 0; i < j; ++i) s += op(a[i], y);
+				if (ALL) for (int i = j + 1; i < N; ++i) s += op(a[i], y);
+				res += s;
+			}
+			part[t] = res;
+		};
+		vector<thread> th;
+		for (int t = 1; t < threads; ++t) th.emplace_back(run, t);
+		run(0);
+		for (thread& t : th) t.join();
+		T ans = 0;
+		for (const T& x : part) ans += x;
+		return ans;
+	}
 };
 
 //ll FloorXoverY(ll x, ll y) { return x / y; }
 //ll XmodY(ll x, ll y) { return x % y; }
+//ll Xor(ll x, ll y) { return x ^ y; }
+//ll And(ll x, ll y) { return x & y; }
+//ll Or(ll x, ll y) { return x | y; }
+//ll Max(ll x, ll y) { return max(x, y); }
+//ll Min(ll x, ll y) { return min(x, y); }
+//ll Abs(ll x, ll y) { return abs(x - y); }
+//ll Gcd(ll x, ll y) { return gcd(x, y); }
 //
 //int main() {
 //	DoubleSigmaVerifier<ll> dv(100, 1000);
 //	dv.verify(dv.BruteForce<FloorXoverY>, DoubleSigma::FloorXoverY<ll>, "XoverY");
-//	dv.verify(dv.BruteForceAllPairs<FloorXoverY>, DoubleSigma::FloorAllPairs<ll>, "XoverYAll");
+//	dv.verify(dv.BruteForceAllPairs<FloorXoverY>, [](const vector<ll>& A) { return DoubleSigma::FloorAllPairs<ll>(A); }, "XoverYAll");
+//	dv.verify(dv.BruteForceAllPairs<FloorXoverY>, [](const vector<ll>& A) { return DoubleSigma::FloorAllPairs<ll>(A, 4); }, "XoverYAll (4 threads)");
 //	dv.verify(dv.BruteForce<XmodY>, DoubleSigma::XmodY<ll>, "XmodY");
+//	dv.verify(dv.BruteForceAllPairs<XmodY>, [](const vector<ll>& A) { return DoubleSigma::XmodYAllPairs<ll>(A); }, "XmodYAll");
+//	dv.verify(dv.BruteForceAllPairs<XmodY>, [](const vector<ll>& A) { return DoubleSigma::XmodYAllPairs<ll>(A, 4); }, "XmodYAll (4 threads)");
+//	dv.verify(dv.BruteForce<FloorXoverY>, DoubleSigma::FloorXoverYLarge<ll>, "XoverYLarge");
+//	dv.verify(dv.BruteForceAllPairs<FloorXoverY>, DoubleSigma::FloorAllPairsLarge<ll>, "XoverYAllLarge");
+//	dv.verify(dv.BruteForce<XmodY>, DoubleSigma::XmodYLarge<ll>, "XmodYLarge");
+//	dv.verify(dv.BruteForceAllPairs<XmodY>, DoubleSigma::XmodYAllPairsLarge<ll>, "XmodYAllLarge");
+//	dv.verify(dv.BruteForce<Xor>, DoubleSigma::XxorY<ll>, "XxorY");
+//	dv.verify(dv.BruteForce<And>, DoubleSigma::XandY<ll>, "XandY");
+//	dv.verify(dv.BruteForce<Or>, DoubleSigma::XorY<ll>, "XorY");
+//	dv.verify(dv.BruteForce<Max>, DoubleSigma::MaxXY<ll>, "MaxXY");
+//	dv.verify(dv.BruteForce<Min>, DoubleSigma::MinXY<ll>, "MinXY");
+//	dv.verify(dv.BruteForce<Abs>, DoubleSigma::AbsXminusY<ll>, "AbsXminusY");
+//	dv.verify(dv.BruteForce<Gcd>, DoubleSigma::XgcdY<ll>, "XgcdY");
+//
+//	// 全部入れて、もう一度全部入れてから消す
+//	auto multiset = [](const vector<ll>& A, bool mod) {
+//		DoubleSigmaMultiset<ll> ms(1000);
+//		for (int k = 0; k < 2; ++k) for (ll a : A) ms.insert((int)a);
+//		for (ll a : A) ms.erase((int)a);
+//		return mod ? ms.mod_sum() : ms.floor_sum();
+//	};
+//	dv.verify(dv.BruteForceAllPairs<FloorXoverY>, [&](const vector<ll>& A) { return multiset(A, false); }, "Multiset floor_sum");
+//	dv.verify(dv.BruteForceAllPairs<XmodY>, [&](const vector<ll>& A) { return multiset(A, true); }, "Multiset mod_sum");
+//
+//	// 本番くらいの大きさで並列の brute force と比べる
+//	using DV = DoubleSigmaVerifier<ll>;
+//	DV::fuzz([](const vector<ll>& A) { return DV::ParallelBruteForce<FloorXoverY>(A); }, DoubleSigma::FloorXoverY<ll>, "XoverY", 100000, 1000000, 1, 1);
+//	DV::fuzz([](const vector<ll>& A) { return DV::ParallelBruteForceAllPairs<XmodY>(A); }, [](const vector<ll>& A) { return DoubleSigma::XmodYAllPairs<ll>(A, 4); }, "XmodYAll", 100000, 1000000, 1, 1);
+//	DV::fuzz([](const vector<ll>& A) { return DV::ParallelBruteForce<Gcd>(A); }, DoubleSigma::XgcdY<ll>, "XgcdY", 30000, 1000000, 1, 1);
+//	DV::fuzz([](const vector<ll>& A) { return DV::ParallelBruteForce<Xor>(A); }, DoubleSigma::XxorY<ll>, "XxorY", 100000, 1LL << 40, 1, 1);
 //}